@@ -24,25 +24,38 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
 # system modules
-from typing import Optional
+from collections import Counter
+from concurrent.futures import ProcessPoolExecutor
+import functools
+import os
+from typing import Dict, List, Optional, Tuple
 
 # dznpy modules
 from ..dznpy_version import VERSION
 from .. import cpp_gen
 from ..ast_view import find_on_fqn
 from ..code_gen_common import BLANK_LINE, CodeGenResult, GeneratedContent, TEXT_GEN_DO_NOT_MODIFY
-from ..cpp_gen import AccessSpecifier, Comment
-from ..misc_utils import TextBlock, namespaceids_t, get_basename
+from ..cpp_gen import AccessSpecifier, Comment, Fqn
+from ..misc_utils import NameSpaceIds, TextBlock, namespaceids_t, get_basename
 from ..support_files import strict_port, ilog, misc_utils, meta_helpers, multi_client_selector, \
-    mutex_wrapped
+    mutex_wrapped, inplace_callable, event_batcher, event_statistics, bounded_dispatcher, \
+    priority_lanes, awaitable, reroute_helpers, event_trace, packaging
 
 # own modules
 from .common import FacilitiesOrigin, Configuration, Recipe, CppPorts, create_encapsulee, \
-    CppElements, DznElements
+    CppElements, DznElements, BatchFlush, DispatcherOverflow, Rerouting, SupportFiles, \
+    ShardedEncapsulee, ShardedFacilities, SupportFilesPackaging, target_file_basename
+from .incremental import IncrementalResult, create_depfile, input_fingerprint
 from .types import AdvShellError
-from .port_selection import PortCfg, PortsSemanticsCfg, PortSelect, PortWildcard
+from .port_selection import EventSelect, PortCfg, PortsSemanticsCfg, PortSelect, PortWildcard
 from .core.processing import create_dzn_elements, create_cpp_portitf, create_facilities, \
-    create_constructor, create_final_construct_fn, create_facilities_check_fn
+    create_constructor, create_final_construct_fn, create_facilities_check_fn, \
+    check_async_in_events, check_batched_out_events, create_flush_out_events_fn, \
+    create_statistics_fn, create_dispatcher_queue_fn, check_dispatcher_capacity, \
+    check_priority_events, create_awaitable_port, dispatcher_name, check_shared_buffer_externs, \
+    check_inplace_externs
+from .core.sharding import check_sharding, create_shards, find_boundary, \
+    create_sharded_constructor, create_sharded_final_construct_fn
 
 
 # helper functions to create a prefined PortCfg
@@ -95,12 +108,141 @@ def all_mts() -> PortCfg:
                                               mts=PortSelect(PortWildcard.ALL)))
 
 
+def create_support_files(ns_prefix: Optional[NameSpaceIds]) -> SupportFiles:
+    """Create all support files with the specified namespace prefix."""
+    files = dict(strict_port=strict_port.create_header(ns_prefix),
+             ilog=ilog.create_header(ns_prefix),
+             misc_utils=misc_utils.create_header(ns_prefix),
+             meta_helpers=meta_helpers.create_header(ns_prefix),
+             multi_client_selector=multi_client_selector.create_header(ns_prefix),
+             mutex_wrapped=mutex_wrapped.create_header(ns_prefix),
+             inplace_callable=inplace_callable.create_header(ns_prefix),
+             event_batcher=event_batcher.create_header(ns_prefix),
+             event_statistics=event_statistics.create_header(ns_prefix),
+             bounded_dispatcher=bounded_dispatcher.create_header(ns_prefix),
+             priority_lanes=priority_lanes.create_header(ns_prefix),
+             awaitable=awaitable.create_header(ns_prefix),
+             reroute_helpers=reroute_helpers.create_header(ns_prefix),
+             event_trace=event_trace.create_header(ns_prefix))
+    return SupportFiles(**files,
+                        umbrella_header=packaging.create_umbrella_header(list(files.values()),
+                                                                         ns_prefix),
+                        module_interface=packaging.create_module_interface(list(files.values()),
+                                                                           ns_prefix))
+
+
+@functools.lru_cache(maxsize=None)
+def _get_support_files(ns_prefix: Optional[Tuple[str, ...]]) -> SupportFiles:
+    """Get the support files for the namespace prefix, created once per process."""
+    return create_support_files(list(ns_prefix) if ns_prefix is not None else None)
+
+
+def get_support_files(ns_prefix: Optional[NameSpaceIds]) -> SupportFiles:
+    """Get the (cached) support files for the namespace prefix."""
+    return _get_support_files(tuple(ns_prefix) if ns_prefix is not None else None)
+
+
+def merge_build_parts(parts: List[Tuple[List[GeneratedContent], List[GeneratedContent]]]) \
+        -> CodeGenResult:
+    """Merge the parts (shell files and support files) of one or more builds into a result with
+    the shell files in order, followed by the support files in order of first use. Equally
+    named support files are equal, because their filename contains the namespace prefix."""
+    shell_files = []
+    support_files = {}
+    for part_shell_files, part_support_files in parts:
+        shell_files.extend(part_shell_files)
+        for file in part_support_files:
+            support_files.setdefault(file.filename, file)
+
+    # e.g. shells of equally named Dezyne files with equal output basename suffixes
+    files = shell_files + list(support_files.values())
+    duplicates = sorted(n for n, c in Counter(f.filename for f in files).items() if c > 1)
+    if duplicates:
+        raise AdvShellError(f'Batch configurations generate duplicate files: {duplicates}')
+
+    return CodeGenResult(files=files)
+
+
+def _build_parts_in_worker(cfgs: List[Configuration]) \
+        -> Tuple[List[GeneratedContent], List[GeneratedContent]]:
+    """Build the parts of configurations in a worker process of Builder.build_parallel()."""
+    return Builder().build_parts(cfgs)
+
+
 class Builder:
-    """Class to build an Advanced Shell according to a user specified configuration."""
-    _recipe: Recipe
+    """Class to build an Advanced Shell according to a user specified configuration. It is
+    stateless, hence an instance can be used re-entrant and by multiple threads at once."""
 
     def build(self, cfg: Configuration) -> CodeGenResult:
         """Build a custom shell according to the specified configuration."""
+        sf = get_support_files(cfg.support_files_ns_prefix)
+        shell_files, support_files = self._build_shell(cfg, sf)
+        return CodeGenResult(files=shell_files + support_files)
+
+    def build_batch(self, cfgs: List[Configuration]) -> CodeGenResult:
+        """Build multiple custom shells from configurations that share the same AST FileContents,
+        of which the symbol index is therefore built once. The support files are generated once
+        per namespace prefix. The result contains each generated file once."""
+        if not cfgs:
+            raise AdvShellError('Batch without configurations')
+        fc = cfgs[0].ast_fc
+        if any(cfg.ast_fc is not fc for cfg in cfgs):
+            raise AdvShellError('Batch configurations do not share the same AST FileContents')
+
+        return merge_build_parts([self.build_parts(cfgs)])
+
+    def build_parallel(self, cfgs: List[Configuration],
+                       max_workers: Optional[int] = None) -> CodeGenResult:
+        """Build multiple custom shells spread over a pool of worker processes (default: one per
+        cpu core). The configurations are split in contiguous chunks, one per worker, so a
+        shared FileContents is transferred once per chunk. The result is identical to that of
+        build_batch(), but the configurations are not required to share a FileContents."""
+        if not cfgs:
+            raise AdvShellError('Batch without configurations')
+        workers = min(max_workers or os.cpu_count() or 1, len(cfgs))
+        if workers == 1:
+            return merge_build_parts([self.build_parts(cfgs)])
+
+        chunk_size = -(-len(cfgs) // workers)  # ceiling
+        chunks = [cfgs[i:i + chunk_size] for i in range(0, len(cfgs), chunk_size)]
+        with ProcessPoolExecutor(max_workers=workers) as executor:
+            return merge_build_parts(list(executor.map(_build_parts_in_worker, chunks)))
+
+    def build_incremental(self, cfgs: List[Configuration],
+                          fingerprints: Dict[str, str]) -> IncrementalResult:
+        """Build only the custom shells of which the input fingerprint differs from the one of the
+        previous build, as provided by fingerprints (keyed by target file basename; empty for a
+        first build). Reply the files of the rebuilt shells and their support files, together
+        with the new fingerprints of all shells. Refer to incremental.input_fingerprint()."""
+        new_fingerprints = {}
+        rebuild_cfgs = []
+        for cfg in cfgs:
+            basename = target_file_basename(cfg)
+            new_fingerprints[basename] = input_fingerprint(cfg)
+            if fingerprints.get(basename) != new_fingerprints[basename]:
+                rebuild_cfgs.append(cfg)
+
+        result = merge_build_parts([self.build_parts(rebuild_cfgs)])
+        return IncrementalResult(result, new_fingerprints,
+                                 [target_file_basename(cfg) for cfg in rebuild_cfgs])
+
+    def build_parts(self, cfgs: List[Configuration]) \
+            -> Tuple[List[GeneratedContent], List[GeneratedContent]]:
+        """Build the shell files of the configurations in order and reply them together with the
+        distinct support files that they require, in order of first use."""
+        shell_files = []
+        support_files = {}
+        for cfg in cfgs:
+            cfg_shell_files, cfg_support_files = \
+                self._build_shell(cfg, get_support_files(cfg.support_files_ns_prefix))
+            shell_files.extend(cfg_shell_files)
+            support_files.update({f.filename: f for f in cfg_support_files})
+        return shell_files, list(support_files.values())
+
+    def _build_shell(self, cfg: Configuration, sf: SupportFiles) \
+            -> Tuple[List[GeneratedContent], List[GeneratedContent]]:
+        """Build the headerfile and sourcefile of a custom shell with the specified support
+        files. Reply them together with the support files that the custom shell requires."""
 
         fc = cfg.ast_fc
 
@@ -112,54 +254,246 @@ class Builder:
             raise AdvShellError(f'Encapsulee {cfg.fqn_encapsulee_name} not found')
 
         dzn_elements = create_dzn_elements(cfg, fc, dzn_encapsulee)
+        check_async_in_events(cfg.async_in_events, dzn_elements.provides_ports)
+        check_batched_out_events(cfg.batched_out_events, dzn_elements.requires_ports)
+        if cfg.instrumentation and cfg.zero_alloc_rerouting:
+            raise AdvShellError('Instrumentation can not be combined with zero heap allocation '
+                                'rerouting')
+        if cfg.zero_alloc_rerouting and cfg.batched_out_events.is_not_empty():
+            raise AdvShellError('Batched out-events can not be combined with zero heap allocation '
+                                'rerouting')
+        if cfg.same_thread_bypass and cfg.batched_out_events.is_not_empty():
+            raise AdvShellError('Same-thread bypass can not be combined with batched out-events')
+        check_dispatcher_capacity(cfg.dispatcher_capacity)
+        is_bounded = cfg.dispatcher_capacity > 0
+        if is_bounded and cfg.zero_alloc_rerouting:
+            raise AdvShellError('Bounded dispatcher can not be combined with zero heap allocation '
+                                'rerouting')
+        if is_bounded and cfg.batched_out_events.is_not_empty():
+            raise AdvShellError('Bounded dispatcher can not be combined with batched out-events')
+        check_priority_events(cfg.priority_events, dzn_elements.provides_ports,
+                              dzn_elements.requires_ports)
+        is_prioritized = cfg.priority_events.is_not_empty()
+        if is_prioritized and (cfg.zero_alloc_rerouting or is_bounded or
+                               cfg.batched_out_events.is_not_empty()):
+            raise AdvShellError('Priority events can not be combined with zero heap allocation '
+                                'rerouting, a bounded dispatcher or batched out-events')
+        if cfg.awaitable_in_events and (cfg.zero_alloc_rerouting or is_bounded or is_prioritized):
+            raise AdvShellError('Awaitable in-events can not be combined with zero heap allocation '
+                                'rerouting, a bounded dispatcher or priority events')
+        check_shared_buffer_externs(cfg.shared_buffer_externs, fc)
+        if cfg.shared_buffer_externs and cfg.zero_alloc_rerouting:
+            raise AdvShellError('Shared buffer externs can not be combined with zero heap '
+                                'allocation rerouting')
+        check_inplace_externs(cfg.inplace_externs, fc)
+        if cfg.inplace_externs and not cfg.zero_alloc_rerouting:
+            raise AdvShellError('Inplace externs require zero heap allocation rerouting')
+        if cfg.reroute_helpers and (cfg.zero_alloc_rerouting or cfg.instrumentation):
+            raise AdvShellError('Reroute helpers can not be combined with zero heap allocation '
+                                'rerouting or instrumentation')
+        if cfg.event_trace and (cfg.zero_alloc_rerouting or cfg.reroute_helpers):
+            raise AdvShellError('Event trace can not be combined with zero heap allocation '
+                                'rerouting or reroute helpers')
+        if cfg.sharded:
+            check_sharding(cfg, dzn_elements)
         scope_fqn = dzn_elements.scope_fqn.ns_ids
 
         # ---------- Prepare C++ Elements ----------
 
         orig_file_basename = get_basename(cfg.dezyne_filename)
-        custom_shell_name = f'{orig_file_basename}{cfg.output_basename_suffix}'
-        target_file_basename = custom_shell_name
+        custom_shell_name = target_file_basename(cfg)
         namespace = cpp_gen.Namespace(ns_ids=scope_fqn)
         struct = cpp_gen.Struct(name=custom_shell_name)
 
+        if cfg.sharded:
+            cpp_elements = self._create_sharded_elements(cfg, sf, dzn_elements, namespace, struct)
+            recipe = Recipe(cfg, dzn_elements, cpp_elements)
+            return self._create_files(recipe), self._required_support_files(recipe, sf)
+
         encapsulee = create_encapsulee(dzn_elements)
+        inline = cfg.header_only  # the definitions are part of the headerfile
 
-        sf_ns_prefix = cfg.support_files_ns_prefix
-        sf_strict_port_hh = strict_port.create_header(sf_ns_prefix)
-        sf_ilog_hh = ilog.create_header(sf_ns_prefix)
-        sf_misc_utils_hh = misc_utils.create_header(sf_ns_prefix)
-        sf_meta_helpers_hh = meta_helpers.create_header(sf_ns_prefix)
-        sf_multi_client_selector_hh = multi_client_selector.create_header(sf_ns_prefix)
-        sf_mutex_wrapped_hh = mutex_wrapped.create_header(sf_ns_prefix)
+        sf_strict_port_hh = sf.strict_port
+        sf_inplace_callable_hh = sf.inplace_callable
+        sf_event_batcher_hh = sf.event_batcher
+        sf_event_statistics_hh = sf.event_statistics
+        sf_bounded_dispatcher_hh = sf.bounded_dispatcher
+        sf_priority_lanes_hh = sf.priority_lanes
+        sf_awaitable_hh = sf.awaitable
 
         support_files_ns = sf_strict_port_hh.namespace
-        pp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, encapsulee) for p in
-                       dzn_elements.provides_ports])
-        rp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, encapsulee) for p in
-                       dzn_elements.requires_ports])
-        facilities = create_facilities(cfg.facilities_origin, struct)
-
-        constructor = create_constructor(struct, facilities, encapsulee, pp, rp, fc)
-        final_construct_fn = create_final_construct_fn(struct, pp, rp, encapsulee)
-        facilities_check_fn = create_facilities_check_fn(struct, cfg.facilities_origin)
-
-        cpp_elements = CppElements(orig_file_basename, target_file_basename, namespace, struct,
-                                   constructor, final_construct_fn, facilities_check_fn, facilities,
-                                   encapsulee, pp, rp, sf_strict_port_hh)
+        pp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, encapsulee, inline=inline)
+                       for p in dzn_elements.provides_ports])
+        rp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, encapsulee, inline=inline)
+                       for p in dzn_elements.requires_ports])
+        facilities = create_facilities(cfg.facilities_origin, struct, inline)
+
+        is_batching = cfg.batched_out_events.is_not_empty()
+        batcher_ns = sf_event_batcher_hh.namespace
+        bounded_ns = sf_bounded_dispatcher_hh.namespace
+        rerouting = Rerouting(
+            async_in_events=cfg.async_in_events,
+            inplace_ns=sf_inplace_callable_hh.namespace if cfg.zero_alloc_rerouting else None,
+            batched_out_events=cfg.batched_out_events,
+            batcher=cpp_gen.decl_var_t(Fqn(batcher_ns + ['EventBatcher<dzn::pump>'], True),
+                                       'm_eventBatcher') if is_batching else None,
+            batch_flush=Fqn(batcher_ns + ['BatchFlush', cfg.batch_flush.value], True)
+            if is_batching else None,
+            statistics=cpp_gen.decl_var_t(Fqn(sf_event_statistics_hh.namespace +
+                                              ['EventStatistics'], True), 'm_statistics')
+            if cfg.instrumentation else None,
+            dispatcher_thread=cpp_gen.decl_var_t(Fqn(['std', 'atomic<std::thread::id>']),
+                                                 'm_dispatcherThread')
+            if cfg.same_thread_bypass else None,
+            bounded_dispatcher=cpp_gen.decl_var_t(Fqn(bounded_ns + ['BoundedDispatcher<dzn::pump>'],
+                                                      True), 'm_boundedDispatcher')
+            if is_bounded else None,
+            dispatcher_capacity=cfg.dispatcher_capacity,
+            dispatcher_overflow=Fqn(bounded_ns + ['DispatcherOverflow',
+                                                  cfg.dispatcher_overflow.value], True)
+            if is_bounded else None,
+            priority_events=cfg.priority_events,
+            priority_lanes=cpp_gen.decl_var_t(Fqn(sf_priority_lanes_hh.namespace +
+                                                  ['PriorityLanes<dzn::pump>'], True),
+                                              'm_priorityLanes')
+            if is_prioritized else None,
+            shared_buffer_externs=cfg.shared_buffer_externs,
+            inplace_externs=cfg.inplace_externs,
+            reroute_helpers_ns=sf.reroute_helpers.namespace if cfg.reroute_helpers else None,
+            trace_ns=sf.event_trace.namespace if cfg.event_trace else None)
+
+        constructor = create_constructor(struct, facilities, encapsulee, pp, rp, fc, rerouting,
+                                         inline)
+        final_construct_fn = create_final_construct_fn(struct, pp, rp, encapsulee,
+                                                       cfg.compile_time_wiring, inline)
+        facilities_check_fn = create_facilities_check_fn(struct, cfg.facilities_origin, inline)
+        awaitable_ports = [create_awaitable_port(p, struct, sf_awaitable_hh.namespace,
+                                                 dispatcher_name(facilities, rerouting), fc,
+                                                 inline)
+                           for p in pp.mts_ports] if cfg.awaitable_in_events else []
+
+        cpp_elements = CppElements(
+            orig_file_basename=orig_file_basename,
+            target_file_basename=custom_shell_name,
+            namespace=namespace,
+            struct=struct,
+            constructor=constructor,
+            final_construct_fn=final_construct_fn,
+            facilities_check_fn=facilities_check_fn,
+            facilities=facilities,
+            encapsulee=encapsulee,
+            provides_ports=pp,
+            requires_ports=rp,
+            sf_strict_port=sf_strict_port_hh,
+            sf_inplace_callable=sf_inplace_callable_hh if cfg.zero_alloc_rerouting else None,
+            sf_event_batcher=sf_event_batcher_hh if is_batching else None,
+            rerouting=rerouting,
+            flush_out_events_fn=create_flush_out_events_fn(struct, rerouting.batcher, inline)
+            if is_batching else None,
+            sf_event_statistics=sf_event_statistics_hh if cfg.instrumentation else None,
+            statistics_fn=create_statistics_fn(struct, rerouting.statistics, inline)
+            if cfg.instrumentation else None,
+            sf_bounded_dispatcher=sf_bounded_dispatcher_hh if is_bounded else None,
+            dispatcher_queue_fn=create_dispatcher_queue_fn(struct, rerouting.bounded_dispatcher,
+                                                           inline) if is_bounded else None,
+            sf_priority_lanes=sf_priority_lanes_hh if is_prioritized else None,
+            sf_awaitable=sf_awaitable_hh if cfg.awaitable_in_events else None,
+            awaitable_ports=awaitable_ports,
+            sf_reroute_helpers=sf.reroute_helpers if cfg.reroute_helpers else None,
+            sf_event_trace=sf.event_trace if cfg.event_trace else None)
 
         # ---------- Generate ----------
-        self._recipe = Recipe(cfg, dzn_elements, cpp_elements)
-
-        # generate c++ code
-        return CodeGenResult(files=[self._create_headerfile(),
-                                    self._create_sourcefile(),
-                                    sf_strict_port_hh, sf_ilog_hh, sf_misc_utils_hh,
-                                    sf_meta_helpers_hh, sf_multi_client_selector_hh,
-                                    sf_mutex_wrapped_hh])
-
-    def _create_headerfile(self) -> GeneratedContent:
-        """Generate a c++ headerfile according to the current recipe."""
-        r = self._recipe
+        recipe = Recipe(cfg, dzn_elements, cpp_elements)
+        return self._create_files(recipe), self._required_support_files(recipe, sf)
+
+    def _create_sharded_elements(self, cfg: Configuration, sf: SupportFiles,
+                                 dzn_elements: DznElements, namespace: cpp_gen.Namespace,
+                                 struct: cpp_gen.Struct) -> CppElements:
+        """Create the C++ elements of a custom shell of which the instances of the encapsulated
+        system are split in shards, each with its own dispatcher and runtime."""
+        inline = cfg.header_only  # the definitions are part of the headerfile
+        shards = create_shards(struct, dzn_elements, inline)
+        boundary = find_boundary(dzn_elements, shards)
+        encapsulee = ShardedEncapsulee(shards, dzn_elements.encapsulee.name)
+
+        support_files_ns = sf.strict_port.namespace
+        pp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, None,
+                                          boundary[p.port.name][1], inline)
+                       for p in dzn_elements.provides_ports])
+        rp = CppPorts([create_cpp_portitf(p, struct, support_files_ns, None,
+                                          boundary[p.port.name][1], inline)
+                       for p in dzn_elements.requires_ports])
+        facilities = ShardedFacilities(FacilitiesOrigin.CREATE, shards)
+
+        rerouting = Rerouting(
+            async_in_events=cfg.async_in_events,
+            inplace_ns=sf.inplace_callable.namespace if cfg.zero_alloc_rerouting else None,
+            batched_out_events=cfg.batched_out_events, batcher=None, batch_flush=None,
+            statistics=None, dispatcher_thread=None, bounded_dispatcher=None,
+            dispatcher_capacity=0, dispatcher_overflow=None,
+            priority_events=cfg.priority_events, priority_lanes=None,
+            shared_buffer_externs=cfg.shared_buffer_externs,
+            inplace_externs=cfg.inplace_externs,
+            reroute_helpers_ns=sf.reroute_helpers.namespace if cfg.reroute_helpers else None,
+            trace_ns=sf.event_trace.namespace if cfg.event_trace else None)
+
+        constructor = create_sharded_constructor(struct, shards, boundary, dzn_elements, pp, rp,
+                                                 rerouting, inline)
+        final_construct_fn = create_sharded_final_construct_fn(struct, shards, pp, rp, inline)
+        facilities_check_fn = create_facilities_check_fn(struct, FacilitiesOrigin.CREATE, inline)
+        awaitable_ports = [create_awaitable_port(p, struct, sf.awaitable.namespace,
+                                                 boundary[p.name][0].facilities.dispatcher.name,
+                                                 dzn_elements.file_contents, inline)
+                           for p in pp.mts_ports] if cfg.awaitable_in_events else []
+
+        return CppElements(
+            orig_file_basename=get_basename(cfg.dezyne_filename),
+            target_file_basename=struct.name,
+            namespace=namespace,
+            struct=struct,
+            constructor=constructor,
+            final_construct_fn=final_construct_fn,
+            facilities_check_fn=facilities_check_fn,
+            facilities=facilities,
+            encapsulee=encapsulee,
+            provides_ports=pp,
+            requires_ports=rp,
+            sf_strict_port=sf.strict_port,
+            sf_inplace_callable=sf.inplace_callable if cfg.zero_alloc_rerouting else None,
+            sf_event_batcher=None,
+            rerouting=rerouting,
+            flush_out_events_fn=None,
+            sf_event_statistics=None,
+            statistics_fn=None,
+            sf_bounded_dispatcher=None,
+            dispatcher_queue_fn=None,
+            sf_priority_lanes=None,
+            sf_awaitable=sf.awaitable if cfg.awaitable_in_events else None,
+            awaitable_ports=awaitable_ports,
+            sf_reroute_helpers=sf.reroute_helpers if cfg.reroute_helpers else None,
+            sf_event_trace=sf.event_trace if cfg.event_trace else None)
+
+    @staticmethod
+    def _required_support_files(r: Recipe, sf: SupportFiles) -> List[GeneratedContent]:
+        """Get the support files that the custom shell requires: the base support files followed
+        by those of the configured features. The umbrella header and module interface aggregate
+        all support files, hence with packaging all support files and the aggregation are
+        required."""
+        packaging = r.configuration.support_files_packaging
+        if packaging != SupportFilesPackaging.HEADERS:
+            return sf.packaged_files(packaging)
+        return sf.base_files + [f for f in r.cpp_elements.feature_support_files
+                                if f not in sf.base_files]
+
+    def _create_files(self, r: Recipe) -> List[GeneratedContent]:
+        """Generate the c++ headerfile and sourcefile according to the recipe. In the header-only
+        mode solely the headerfile is generated, with the definitions inline."""
+        if r.configuration.header_only:
+            return [self._create_headerfile(r)]
+        return [self._create_headerfile(r), self._create_sourcefile(r)]
+
+    def _create_headerfile(self, r: Recipe) -> GeneratedContent:
+        """Generate a c++ headerfile according to the recipe."""
         cfg = r.configuration
         cpp = r.cpp_elements
 
@@ -168,32 +502,75 @@ class Builder:
             BLANK_LINE,
             'Advanced Shell',
             BLANK_LINE,
-            self._create_creator_info_overview(),
+            self._create_creator_info_overview(r),
             BLANK_LINE,
-            self._create_configuration_overview(),
+            self._create_configuration_overview(r),
             BLANK_LINE,
-            self._create_final_port_overview(),
+            self._create_final_port_overview(r),
             TEXT_GEN_DO_NOT_MODIFY,
         ])
 
         header = [header_comments,
                   BLANK_LINE,
-                  cpp_gen.SystemIncludes(cpp.facilities.system_includes),
-                  cpp_gen.ProjectIncludes([f'{r.cpp_elements.orig_file_basename}.hh',
-                                           f'{cpp.sf_strict_port.filename}']),
-                  BLANK_LINE]
+                  cpp_gen.SystemIncludes(cpp.facilities.system_includes +
+                                         (['atomic', 'thread'] if cpp.rerouting.dispatcher_thread
+                                          else []) +
+                                         ([i for i in self._definitions_system_includes(r) if
+                                           i not in cpp.facilities.system_includes]
+                                          if cfg.header_only else [])),
+                  cpp_gen.ProjectIncludes([f'{r.cpp_elements.orig_file_basename}.hh'] +
+                                          self._support_files_includes(r)),
+                  BLANK_LINE,
+                  [f'import {packaging.module_name(cpp.sf_strict_port.namespace)};', BLANK_LINE]
+                  if cfg.support_files_packaging == SupportFilesPackaging.MODULE else None]
 
         public_section = TextBlock([cpp.constructor.as_decl,
                                     cpp.final_construct_fn.as_decl,
+                                    cpp.flush_out_events_fn.as_decl
+                                    if cpp.flush_out_events_fn else None,
+                                    cpp.statistics_fn.as_decl if cpp.statistics_fn else None,
+                                    cpp.dispatcher_queue_fn.as_decl
+                                    if cpp.dispatcher_queue_fn else None,
                                     BLANK_LINE,
                                     cpp.facilities.accessors_decl,
                                     BLANK_LINE,
                                     cpp.provides_ports.accessors_decl,
                                     BLANK_LINE,
                                     cpp.requires_ports.accessors_decl,
+                                    [[BLANK_LINE,
+                                      Comment('Awaitable in-events of the provides ports (MTS), '
+                                              'the coroutine resumes via the resumer (default: '
+                                              'on the dispatcher thread)'),
+                                      BLANK_LINE.join(str(p.as_decl) for p in
+                                                      cpp.awaitable_ports)]]
+                                    if cpp.awaitable_ports else None,
                                     ])
 
+        batcher = cpp.rerouting.batcher
+        statistics = cpp.rerouting.statistics
         private_section = TextBlock([cpp.facilities.member_variables,
+                                     TextBlock([BLANK_LINE, Comment('Batching of out-events'),
+                                                batcher, BLANK_LINE])
+                                     if batcher else None,
+                                     TextBlock([BLANK_LINE, Comment('Instrumentation of events'),
+                                                statistics, BLANK_LINE])
+                                     if statistics else None,
+                                     TextBlock([None if statistics else BLANK_LINE,
+                                                Comment('Thread of the dispatcher (same-thread '
+                                                        'bypass)'),
+                                                cpp.rerouting.dispatcher_thread, BLANK_LINE])
+                                     if cpp.rerouting.dispatcher_thread else None,
+                                     TextBlock([None if statistics or
+                                                cpp.rerouting.dispatcher_thread else BLANK_LINE,
+                                                Comment('Bounded admission of events to the '
+                                                        'dispatcher'),
+                                                cpp.rerouting.bounded_dispatcher, BLANK_LINE])
+                                     if cpp.rerouting.bounded_dispatcher else None,
+                                     TextBlock([None if statistics or
+                                                cpp.rerouting.dispatcher_thread else BLANK_LINE,
+                                                Comment('Prioritized dispatching of events'),
+                                                cpp.rerouting.priority_lanes, BLANK_LINE])
+                                     if cpp.rerouting.priority_lanes else None,
                                      cpp.facilities_check_fn.as_decl,
                                      BLANK_LINE,
                                      cpp.encapsulee,
@@ -214,15 +591,26 @@ class Builder:
                 contents=private_section)
         ])
         cpp.namespace.contents = str(cpp.struct)
+        if cfg.header_only:
+            cpp.namespace.contents = [str(cpp.struct), str(TextBlock(self._create_definitions(r)))]
 
         footer = Comment(f'Generated by: dznpy/adv_shell v{VERSION}')
 
         return GeneratedContent(filename=f'{cpp.target_file_basename}.hh',
                                 contents=str(TextBlock([header, cpp.namespace, footer])))
 
-    def _create_sourcefile(self) -> GeneratedContent:
-        """Generate a c++ sourcefile according to the current recipe."""
-        r = self._recipe
+    def _support_files_includes(self, r: Recipe) -> List[str]:
+        """Get the project includes of the support files used by the custom shell, being the
+        umbrella header or none (the module is imported) when the support files are packaged."""
+        cpp = r.cpp_elements
+        if r.configuration.support_files_packaging == SupportFilesPackaging.UMBRELLA_HEADER:
+            return [f'{"_".join(cpp.sf_strict_port.namespace)}_SupportFiles.hh']
+        if r.configuration.support_files_packaging == SupportFilesPackaging.MODULE:
+            return []
+        return [f'{sf.filename}' for sf in cpp.feature_support_files]
+
+    def _create_sourcefile(self, r: Recipe) -> GeneratedContent:
+        """Generate a c++ sourcefile according to the recipe."""
         cfg = r.configuration
         cpp = r.cpp_elements
 
@@ -236,43 +624,61 @@ class Builder:
 
         header = [header_comments,
                   BLANK_LINE,
-                  cpp_gen.SystemIncludes(['dzn/runtime.hh']),  # used by FacilitiesCheck()
+                  cpp_gen.SystemIncludes(self._definitions_system_includes(r)),
                   cpp_gen.ProjectIncludes([f'{cpp.target_file_basename}.hh']),
                   BLANK_LINE]
 
-        # fill the struct declaration with the public and private sections
-        cpp.namespace.contents = [BLANK_LINE,
-                                  cpp.facilities_check_fn.as_def,
-                                  BLANK_LINE,
-                                  cpp.constructor.as_def,
-                                  BLANK_LINE,
-                                  cpp.final_construct_fn.as_def,
-                                  BLANK_LINE,
-                                  cpp.facilities.accessors_def,
-                                  BLANK_LINE,
-                                  cpp.provides_ports.accessors_def,
-                                  BLANK_LINE,
-                                  cpp.requires_ports.accessors_def,
-                                  BLANK_LINE,
-                                  ]
+        cpp.namespace.contents = self._create_definitions(r)
 
         footer = Comment(f'Generated by: dznpy/adv_shell v{VERSION}')
 
         return GeneratedContent(filename=f'{cpp.target_file_basename}.cc',
                                 contents=str(TextBlock([header, cpp.namespace, footer])))
 
-    def _create_creator_info_overview(self) -> Optional[str]:
+    def _definitions_system_includes(self, r: Recipe) -> List[str]:
+        """Get the system includes used by the definitions of the custom shell, where
+        dzn/runtime.hh is used by FacilitiesCheck()."""
+        cfg = r.configuration
+        return ['dzn/runtime.hh'] + \
+            (['type_traits', 'utility'] if cfg.compile_time_wiring else []) + \
+            (['memory'] if cfg.shared_buffer_externs else [])
+
+    def _create_definitions(self, r: Recipe) -> list:
+        """Create the c++ definitions of the custom shell, each preceded by an empty line."""
+        cpp = r.cpp_elements
+        return [BLANK_LINE,
+                cpp.facilities_check_fn.as_def,
+                BLANK_LINE,
+                cpp.constructor.as_def,
+                BLANK_LINE,
+                cpp.final_construct_fn.as_def,
+                BLANK_LINE,
+                [cpp.flush_out_events_fn.as_def, BLANK_LINE]
+                if cpp.flush_out_events_fn else None,
+                [cpp.statistics_fn.as_def, BLANK_LINE]
+                if cpp.statistics_fn else None,
+                [cpp.dispatcher_queue_fn.as_def, BLANK_LINE]
+                if cpp.dispatcher_queue_fn else None,
+                cpp.facilities.accessors_def,
+                BLANK_LINE,
+                cpp.provides_ports.accessors_def,
+                BLANK_LINE,
+                cpp.requires_ports.accessors_def,
+                BLANK_LINE,
+                [[p.as_def, BLANK_LINE] for p in cpp.awaitable_ports],
+                ]
+
+    def _create_creator_info_overview(self, r: Recipe) -> Optional[str]:
         """Create the creator information overview"""
-        cfg = self._recipe.configuration
+        cfg = r.configuration
 
         return str(TextBlock([
             'Creator information:',
             TextBlock(cfg.creator_info).indent() if cfg.creator_info else '<none>',
         ]))
 
-    def _create_configuration_overview(self) -> str:
+    def _create_configuration_overview(self, r: Recipe) -> str:
         """Create the configuration overview"""
-        r = self._recipe
         cfg = r.configuration
         cpp = r.cpp_elements
 
@@ -283,11 +689,35 @@ class Builder:
             f'- Target file basename: {cpp.target_file_basename}',
             f'- Dezyne facilities: {cfg.facilities_origin.value}',
             f'- Port semantics: {cfg.port_cfg}',
+            f'- Asynchronous in-events: {cfg.async_in_events}'
+            if cfg.async_in_events.is_not_empty() else None,
+            '- Event rerouting: zero heap allocations' if cfg.zero_alloc_rerouting else None,
+            f'- Batched out-events: {cfg.batched_out_events} (flush: {cfg.batch_flush.value})'
+            if cfg.batched_out_events.is_not_empty() else None,
+            '- Instrumentation: event latencies and queue depth' if cfg.instrumentation else None,
+            '- Port wiring: compile-time checked, functors moved'
+            if cfg.compile_time_wiring else None,
+            '- Same-thread bypass: in-events raised on the dispatcher thread are handled directly'
+            if cfg.same_thread_bypass else None,
+            f'- Bounded dispatcher: capacity {cfg.dispatcher_capacity} '
+            f'(overflow: {cfg.dispatcher_overflow.value})' if cfg.dispatcher_capacity else None,
+            f'- Priority events: {cfg.priority_events}'
+            if cfg.priority_events.is_not_empty() else None,
+            f'- Sharded dispatchers: {cpp.facilities.overview}' if cfg.sharded else None,
+            '- Awaitable in-events: C++20 coroutines' if cfg.awaitable_in_events else None,
+            f'- Shared buffer externs: {sorted(cfg.shared_buffer_externs)}'
+            if cfg.shared_buffer_externs else None,
+            f'- Inplace externs: {sorted(cfg.inplace_externs)}' if cfg.inplace_externs else None,
+            '- Event rerouting: shared template helpers' if cfg.reroute_helpers else None,
+            '- Header-only: definitions inline, no sourcefile' if cfg.header_only else None,
+            '- Event trace: per-thread ring buffers' if cfg.event_trace else None,
+            f'- Support files: {cfg.support_files_packaging.value}'
+            if cfg.support_files_packaging != SupportFilesPackaging.HEADERS else None,
         ]))
 
-    def _create_final_port_overview(self) -> str:
+    def _create_final_port_overview(self, r: Recipe) -> str:
         """Create the final port overview."""
-        cpp = self._recipe.cpp_elements
+        cpp = r.cpp_elements
 
         def port_and_itf_name(ports) -> str:
             return '\n'.join([f'- {p.name}: {p.dzn_port_itf.interface.name}' for p in ports])
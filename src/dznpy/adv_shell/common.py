@@ -8,18 +8,19 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 # system modules
 from dataclasses import dataclass, field
 import enum
-from typing import List, Optional
+from typing import List, Optional, Set
 
 # dznpy modules
 from .. import cpp_gen, ast
+from ..ast_view import Shard
 from ..code_gen_common import BLANK_LINE, GeneratedContent
 from ..cpp_gen import Comment, Constructor, Function, MemberVariable, Fqn, Namespace, Struct, \
     TypeDesc
-from ..misc_utils import NameSpaceIds, TextBlock
+from ..misc_utils import NameSpaceIds, TextBlock, get_basename
 
 # own modules
 from .types import RuntimeSemantics
-from .port_selection import PortCfg
+from .port_selection import EventSelect, PortCfg, PortWildcard
 
 
 @dataclass(frozen=True)
@@ -39,6 +40,7 @@ class CppPortItf:
     accessor_fn: Function
     accessor_target: str
     member_var: Optional[MemberVariable]
+    encapsulee_port: str  # the C++ expression of the respective port of the encapsulee
 
     @property
     def name(self) -> str:
@@ -59,12 +61,52 @@ class CppPortItf:
         return self.accessor_fn.as_def
 
 
+@dataclass(frozen=True)
+class CppAwaitablePort:
+    """Data class grouping the C++ nested struct with an awaitable function per in-event of a
+    provides port (MTS) and the accessor function that creates it."""
+    port: CppPortItf
+    struct: Struct
+    accessor_fn: Function
+    event_fns: List[Function]
+
+    @property
+    def as_decl(self) -> TextBlock:
+        """Create a C++ textblock with the declaration of the nested struct and its accessor."""
+        return TextBlock([str(self.struct), self.accessor_fn.as_decl])
+
+    @property
+    def as_def(self) -> str:
+        """Create the definitions of the accessor and the awaitable functions."""
+        return BLANK_LINE.join([self.accessor_fn.as_def] + [fn.as_def for fn in self.event_fns])
+
+
 class FacilitiesOrigin(enum.Enum):
     """Enum to indicate the origin of the facilities."""
     IMPORT = 'Import facilities (by reference) from the user provides dzn::locator argument'
     CREATE = 'Create all facilities (dispatcher, runtime and locator)'
 
 
+class BatchFlush(enum.Enum):
+    """Enum to indicate when a batch of out-events is posted to the dispatcher."""
+    BURST = 'Burst'
+    EXPLICIT = 'Explicit'
+
+
+class DispatcherOverflow(enum.Enum):
+    """Enum to indicate the behaviour of the bounded dispatcher when its ring buffer is full."""
+    BLOCK = 'Block'
+    DROP_OLDEST = 'DropOldest'
+    REJECT = 'Reject'
+
+
+class SupportFilesPackaging(enum.Enum):
+    """Enum to indicate how a shell includes the support files."""
+    HEADERS = 'Separate headers'
+    UMBRELLA_HEADER = 'Umbrella header'
+    MODULE = 'C++20 module'
+
+
 @dataclass
 class Configuration:
     """Data class containing the user specified configuration for generating an Advanced Shell."""
@@ -78,6 +120,30 @@ class Configuration:
     support_files_ns_prefix: Optional[NameSpaceIds] = field(default=None)
     creator_info: Optional[str] = field(default=None)
     verbose: bool = field(default=False)
+    async_in_events: EventSelect = field(default=EventSelect(PortWildcard.NONE))
+    zero_alloc_rerouting: bool = field(default=False)
+    batched_out_events: EventSelect = field(default=EventSelect(PortWildcard.NONE))
+    batch_flush: BatchFlush = field(default=BatchFlush.BURST)
+    instrumentation: bool = field(default=False)
+    compile_time_wiring: bool = field(default=False)
+    same_thread_bypass: bool = field(default=False)
+    dispatcher_capacity: int = field(default=0)  # 0: unbounded, the dzn::pump is used directly
+    dispatcher_overflow: DispatcherOverflow = field(default=DispatcherOverflow.BLOCK)
+    priority_events: EventSelect = field(default=EventSelect(PortWildcard.NONE))
+    sharded: bool = field(default=False)
+    awaitable_in_events: bool = field(default=False)
+    shared_buffer_externs: Set[str] = field(default_factory=set)  # fqn, e.g. 'My.Project.Image'
+    inplace_externs: Set[str] = field(default_factory=set)  # fqn, e.g. 'My.Project.Handle'
+    reroute_helpers: bool = field(default=False)
+    header_only: bool = field(default=False)
+    support_files_packaging: SupportFilesPackaging = field(default=SupportFilesPackaging.HEADERS)
+    event_trace: bool = field(default=False)
+
+
+def target_file_basename(cfg: Configuration) -> str:
+    """Get the basename of the files generated for the shell: the basename of the Dezyne file
+    followed by the output basename suffix."""
+    return f'{get_basename(cfg.dezyne_filename)}{cfg.output_basename_suffix}'
 
 
 @dataclass
@@ -173,6 +239,83 @@ class Facilities:
         return result
 
 
+@dataclass(frozen=True)
+class CppShard:
+    """Data class comprising a shard of an encapsulated system: the instances that are bound to
+    each other and its own Dezyne C++ facilities (dispatcher, runtime and locator)."""
+    nr: int
+    dzn_shard: Shard
+    facilities: Facilities
+    instances: List[MemberVariable]
+
+    @property
+    def instance_names(self) -> List[str]:
+        """Get the names of the instances as declared in the system."""
+        return [x.name for x in self.dzn_shard.instances]
+
+
+@dataclass(frozen=True)
+class ShardedFacilities:
+    """Data class grouping the self created Dezyne C++ facilities of all shards, with the same
+    declarations and definitions as Facilities."""
+    origin: FacilitiesOrigin
+    shards: List[CppShard]
+
+    @property
+    def accessors_decl(self) -> TextBlock:
+        """Create a C++ textblock with the declaration of the accessors."""
+        acc_str = 'accessors' if len(self.shards) > 1 else 'accessor'
+        return TextBlock([Comment(f'Facility {acc_str} (per shard)'),
+                          [s.facilities.locator_accessor_fn.as_decl for s in self.shards]])
+
+    @property
+    def accessors_def(self) -> TextBlock:
+        """Create a C++ textblock with the definition of the accessors."""
+        return TextBlock(BLANK_LINE.join([s.facilities.locator_accessor_fn.as_def for s in
+                                          self.shards]))
+
+    @property
+    def member_variables(self) -> TextBlock:
+        """Create a C++ textblock with the declaration of the facilities of each shard as member
+        variables."""
+        return TextBlock(BLANK_LINE.join([str(TextBlock([
+            Comment(f'Facilities of shard {s.nr} (instances: {", ".join(s.instance_names)})'),
+            [str(mv) for mv in [s.facilities.runtime, s.facilities.dispatcher,
+                                s.facilities.locator]]])) for s in self.shards]))
+
+    @property
+    def system_includes(self) -> List[str]:
+        """Create a list of the required (Dezyne) header file includes."""
+        return ['dzn/locator.hh', 'dzn/pump.hh', 'dzn/runtime.hh']
+
+    @property
+    def overview(self) -> str:
+        """Get a one-line overview of the shards and their instances."""
+        shards_str = ', '.join(f'({", ".join(s.instance_names)})' for s in self.shards)
+        return f'{len(self.shards)} threaded subsystems {shards_str}'
+
+
+@dataclass(frozen=True)
+class Rerouting:
+    """Data class grouping the configured variations on rerouting events via the dispatcher."""
+    async_in_events: EventSelect
+    inplace_ns: Optional[NameSpaceIds]  # namespace of the Inplace Callable support file
+    batched_out_events: EventSelect
+    batcher: Optional[MemberVariable]  # the Event Batcher, present when out-events are batched
+    batch_flush: Optional[Fqn]  # the C++ enum value of the BatchFlush mode of the Event Batcher
+    statistics: Optional[MemberVariable]  # the Event Statistics, present when instrumented
+    dispatcher_thread: Optional[MemberVariable]  # present when in-events can bypass the dispatcher
+    bounded_dispatcher: Optional[MemberVariable]  # the Bounded Dispatcher, present when bounded
+    dispatcher_capacity: int  # the capacity of the Bounded Dispatcher
+    dispatcher_overflow: Optional[Fqn]  # the C++ enum value of its DispatcherOverflow behaviour
+    priority_events: EventSelect
+    priority_lanes: Optional[MemberVariable]  # the Priority Lanes, present with priority events
+    shared_buffer_externs: Set[str]  # fqns of the extern types passed as shared buffer
+    inplace_externs: Set[str]  # fqns of the extern types captured by value without allocation
+    reroute_helpers_ns: Optional[NameSpaceIds]  # namespace of the Reroute Helpers support file
+    trace_ns: Optional[NameSpaceIds]  # namespace of the Event Trace support file, when tracing
+
+
 @dataclass(frozen=True)
 class DznElements:
     """Data class providing the model of the dezyne elements required for the Advanced Shell."""
@@ -194,6 +337,18 @@ class CppEncapsulee:
                               self.member_var]))
 
 
+@dataclass(frozen=True)
+class ShardedEncapsulee:
+    """Data class comprising attributes of a C++ encapsulee of which the instances are sharded."""
+    shards: List[CppShard]
+    name: str
+
+    def __str__(self):
+        return str(TextBlock([Comment(f'The instances of the encapsulated system "{self.name}", '
+                                      'per shard'),
+                              [[Comment(f'- shard {s.nr}'), s.instances] for s in self.shards]]))
+
+
 def create_encapsulee(dzn_elements: DznElements) -> CppEncapsulee:
     """Helper function to create an C++ encapsulee data class"""
     return CppEncapsulee(cpp_gen.decl_var_t(Fqn(dzn_elements.encapsulee.fqn, True), 'm_encapsulee'),
@@ -210,11 +365,75 @@ class CppElements:
     constructor: Constructor
     final_construct_fn: Function
     facilities_check_fn: Function
-    facilities: Facilities
-    encapsulee: CppEncapsulee
+    facilities: Facilities or ShardedFacilities
+    encapsulee: CppEncapsulee or ShardedEncapsulee
     provides_ports: CppPorts
     requires_ports: CppPorts
     sf_strict_port: GeneratedContent  # support file 'Dzn_StrictPort'
+    sf_inplace_callable: Optional[GeneratedContent]  # support file 'Dzn_InplaceCallable'
+    sf_event_batcher: Optional[GeneratedContent]  # support file 'Dzn_EventBatcher'
+    rerouting: Rerouting
+    flush_out_events_fn: Optional[Function]
+    sf_event_statistics: Optional[GeneratedContent]  # support file 'Dzn_EventStatistics'
+    statistics_fn: Optional[Function]
+    sf_bounded_dispatcher: Optional[GeneratedContent]  # support file 'Dzn_BoundedDispatcher'
+    dispatcher_queue_fn: Optional[Function]
+    sf_priority_lanes: Optional[GeneratedContent]  # support file 'Dzn_PriorityLanes'
+    sf_awaitable: Optional[GeneratedContent]  # support file 'Dzn_Awaitable'
+    awaitable_ports: List[CppAwaitablePort]
+    sf_reroute_helpers: Optional[GeneratedContent]  # support file 'Dzn_RerouteHelpers'
+    sf_event_trace: Optional[GeneratedContent]  # support file 'Dzn_EventTrace'
+
+    @property
+    def feature_support_files(self) -> List[GeneratedContent]:
+        """Get the support files that are included by the custom shell, in order of inclusion."""
+        return [sf for sf in [self.sf_strict_port, self.sf_inplace_callable, self.sf_event_batcher,
+                              self.sf_event_statistics, self.sf_bounded_dispatcher,
+                              self.sf_priority_lanes, self.sf_awaitable, self.sf_reroute_helpers,
+                              self.sf_event_trace] if sf]
+
+
+@dataclass(frozen=True)
+class SupportFiles:
+    """Data class grouping the support files generated for a namespace prefix."""
+    strict_port: GeneratedContent  # support file 'Dzn_StrictPort'
+    ilog: GeneratedContent  # support file 'Dzn_ILog'
+    misc_utils: GeneratedContent  # support file 'Dzn_MiscUtils'
+    meta_helpers: GeneratedContent  # support file 'Dzn_MetaHelpers'
+    multi_client_selector: GeneratedContent  # support file 'Dzn_MultiClientSelector'
+    mutex_wrapped: GeneratedContent  # support file 'Dzn_MutexWrapped'
+    inplace_callable: GeneratedContent  # support file 'Dzn_InplaceCallable'
+    event_batcher: GeneratedContent  # support file 'Dzn_EventBatcher'
+    event_statistics: GeneratedContent  # support file 'Dzn_EventStatistics'
+    bounded_dispatcher: GeneratedContent  # support file 'Dzn_BoundedDispatcher'
+    priority_lanes: GeneratedContent  # support file 'Dzn_PriorityLanes'
+    awaitable: GeneratedContent  # support file 'Dzn_Awaitable'
+    reroute_helpers: GeneratedContent  # support file 'Dzn_RerouteHelpers'
+    event_trace: GeneratedContent  # support file 'Dzn_EventTrace'
+    umbrella_header: GeneratedContent  # aggregation 'Dzn_SupportFiles.hh' of all support files
+    module_interface: GeneratedContent  # aggregation 'Dzn_SupportFiles.cppm' of all support files
+
+    @property
+    def base_files(self) -> List[GeneratedContent]:
+        """Get the support files that are generated for every custom shell."""
+        return [self.strict_port, self.ilog, self.misc_utils, self.meta_helpers,
+                self.multi_client_selector, self.mutex_wrapped]
+
+    @property
+    def files(self) -> List[GeneratedContent]:
+        """Get all support files."""
+        return [self.strict_port, self.ilog, self.misc_utils, self.meta_helpers,
+                self.multi_client_selector, self.mutex_wrapped, self.inplace_callable,
+                self.event_batcher, self.event_statistics, self.bounded_dispatcher,
+                self.priority_lanes, self.awaitable, self.reroute_helpers, self.event_trace]
+
+    def packaged_files(self, packaging: SupportFilesPackaging) -> List[GeneratedContent]:
+        """Get all support files followed by their aggregation of the specified packaging."""
+        if packaging == SupportFilesPackaging.UMBRELLA_HEADER:
+            return self.files + [self.umbrella_header]
+        if packaging == SupportFilesPackaging.MODULE:
+            return self.files + [self.module_interface]
+        return self.files
 
 
 @dataclass(frozen=True)
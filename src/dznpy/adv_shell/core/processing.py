@@ -6,6 +6,7 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
 # system modules
+from typing import List, Optional, Set, Tuple
 
 # dznpy modules
 from ... import cpp_gen, ast, ast_view
@@ -13,12 +14,13 @@ from ...ast import Component, System
 from ...ast_view import find_on_fqn
 from ...code_gen_common import BLANK_LINE
 from ...cpp_gen import Comment, Constructor, Function, FunctionPrefix, Fqn, MemberVariable, \
-    TypeDesc, TypePostfix, const_param_ref_t, const_param_ptr_t, void_t
+    Param, TypeDesc, TypePostfix, const_param_ref_t, const_param_ptr_t, void_t
 from ...misc_utils import flatten_to_strlist, NameSpaceIds, TextBlock
 
 # own modules
-from ..common import Configuration, CppPortItf, DznPortItf, \
+from ..common import Configuration, CppAwaitablePort, CppPortItf, DznPortItf, Rerouting, \
     FacilitiesOrigin, DznElements, Facilities, CppEncapsulee, CppPorts
+from ..port_selection import EventSelect
 from ..types import AdvShellError, RuntimeSemantics
 
 
@@ -46,8 +48,94 @@ def create_dzn_elements(cfg: Configuration, file_contents: ast.FileContents,
     return DznElements(file_contents, encapsulee, Fqn(scope_fqn), provides_ports, requires_ports)
 
 
-def create_facilities(origin: FacilitiesOrigin, scope) -> Facilities:
-    """create_facilities"""
+def is_async_in_event_eligible(event: ast.Event) -> bool:
+    """Check whether an in-event can be posted asynchronously (fire-and-forget) to the
+    dispatcher. That requires a void return type and solely formals with direction 'in'."""
+    return event.signature.type_name.value == ['void'] and \
+        all(f.direction == ast.FormalDirection.IN for f in event.signature.formals.elements)
+
+
+def check_async_in_events(selection: EventSelect, provides_ports: List[DznPortItf]):
+    """Check the user configured selection of asynchronous in-events against the provides ports
+    of the encapsulee. Raise an AdvShellError on a mismatch."""
+    ports = {p.port.name: p for p in provides_ports}
+
+    unmatched = selection.port_names() - set(ports)
+    if unmatched:
+        raise AdvShellError(f'Configured async in-event ports {sorted(unmatched)} not matched')
+
+    for port_name in sorted(selection.port_names()):
+        if ports[port_name].semantics != RuntimeSemantics.MTS:
+            raise AdvShellError(f'Async in-events require port "{port_name}" to be configured '
+                                'with MTS')
+
+    for item in sorted(x for x in selection.tryget_strset() if '.' in x):
+        port_name, event_name = item.split('.')
+        events = [e for e in ports[port_name].interface.events.elements if
+                  e.direction == ast.EventDirection.IN and e.name == event_name]
+        if not events:
+            raise AdvShellError(f'Configured async in-event "{item}" not found')
+        if not is_async_in_event_eligible(events[0]):
+            raise AdvShellError(f'Configured async in-event "{item}" must have a void return '
+                                'type and only in-formals')
+
+
+def check_batched_out_events(selection: EventSelect, requires_ports: List[DznPortItf]):
+    """Check the user configured selection of batched out-events against the requires ports
+    of the encapsulee. Raise an AdvShellError on a mismatch."""
+    ports = {p.port.name: p for p in requires_ports}
+
+    unmatched = selection.port_names() - set(ports)
+    if unmatched:
+        raise AdvShellError(f'Configured batched out-event ports {sorted(unmatched)} not matched')
+
+    for port_name in sorted(selection.port_names()):
+        if ports[port_name].semantics != RuntimeSemantics.MTS:
+            raise AdvShellError(f'Batched out-events require port "{port_name}" to be configured '
+                                'with MTS')
+
+    for item in sorted(x for x in selection.tryget_strset() if '.' in x):
+        port_name, event_name = item.split('.')
+        if not [e for e in ports[port_name].interface.events.elements if
+                e.direction == ast.EventDirection.OUT and e.name == event_name]:
+            raise AdvShellError(f'Configured batched out-event "{item}" not found')
+
+
+def check_priority_events(selection: EventSelect, provides_ports: List[DznPortItf],
+                          requires_ports: List[DznPortItf]):
+    """Check the user configured selection of priority events against the rerouted events of the
+    encapsulee: in-events of provides ports and out-events of requires ports. Raise an
+    AdvShellError on a mismatch."""
+    ports = {p.port.name: p for p in provides_ports + requires_ports}
+    provides_names = {p.port.name for p in provides_ports}
+
+    unmatched = selection.port_names() - set(ports)
+    if unmatched:
+        raise AdvShellError(f'Configured priority event ports {sorted(unmatched)} not matched')
+
+    for port_name in sorted(selection.port_names()):
+        if ports[port_name].semantics != RuntimeSemantics.MTS:
+            raise AdvShellError(f'Priority events require port "{port_name}" to be configured '
+                                'with MTS')
+
+    for item in sorted(x for x in selection.tryget_strset() if '.' in x):
+        port_name, event_name = item.split('.')
+        direction = ast.EventDirection.IN if port_name in provides_names else \
+            ast.EventDirection.OUT
+        if not [e for e in ports[port_name].interface.events.elements if
+                e.direction == direction and e.name == event_name]:
+            raise AdvShellError(f'Configured priority event "{item}" not found')
+
+
+def check_dispatcher_capacity(capacity: int):
+    """Check the user configured capacity of the Bounded Dispatcher, where 0 disables it.
+    Raise an AdvShellError when it is not a non-negative integer."""
+    if not isinstance(capacity, int) or isinstance(capacity, bool) or capacity < 0:
+        raise AdvShellError(f'Dispatcher capacity {capacity!r} must be a non-negative integer')
+
+
+def create_facilities(origin: FacilitiesOrigin, scope, inline: bool = False) -> Facilities:
+    """create_facilities. The definitions are inline when specified (e.g. header-only)."""
     if origin == FacilitiesOrigin.IMPORT:
         dispatcher_mv = cpp_gen.decl_var_ref_t(Fqn(['dzn', 'pump']), 'm_dispatcher')
         return Facilities(origin, dispatcher_mv, None, None, None)
@@ -60,7 +148,7 @@ def create_facilities(origin: FacilitiesOrigin, scope) -> Facilities:
 
         locator_accessor_fn = Function(TypeDesc(locator_t.fqn, TypePostfix.REFERENCE),
                                        'Locator', scope=scope,
-                                       contents=f'return {locator_mv.name};')
+                                       contents=f'return {locator_mv.name};', inline=inline)
 
         return Facilities(origin, dispatcher_mv, runtime_mv, locator_mv, locator_accessor_fn)
 
@@ -68,8 +156,13 @@ def create_facilities(origin: FacilitiesOrigin, scope) -> Facilities:
 
 
 def create_cpp_portitf(dzn: DznPortItf, scope: cpp_gen.Struct, support_files_ns: NameSpaceIds,
-                       encapsulee: CppEncapsulee) -> CppPortItf:
-    """create_cpp_portitf"""
+                       encapsulee: CppEncapsulee, encapsulee_port: Optional[str] = None,
+                       inline: bool = False) -> CppPortItf:
+    """create_cpp_portitf. By default the respective port of the encapsulee is its member with
+    the same name, unless the C++ expression of the encapsulee port is specified. The accessor
+    definition is inline when specified (e.g. header-only)."""
+    if encapsulee_port is None:
+        encapsulee_port = f'{encapsulee.member_var.name}.{dzn.port.name}'
     t = TypeDesc(Fqn(dzn.interface.fqn, prefix_root_ns=True))
     fn_prefix = f'{dzn.port.direction.value}'
     cap_name = dzn.port.name[0].upper() + dzn.port.name[1:]
@@ -79,10 +172,10 @@ def create_cpp_portitf(dzn: DznPortItf, scope: cpp_gen.Struct, support_files_ns:
         member_var = None
         wrap_strict_sts = TypeDesc(
             Fqn(support_files_ns + [f'Sts<{TypeDesc(t.fqn)}>'], prefix_root_ns=True))
-        accessor_target = f'{encapsulee.member_var.name}.{dzn.port.name}'
+        accessor_target = encapsulee_port
         accessor_fn = Function(wrap_strict_sts,
                                f'{fn_prefix}{cap_name}', scope=scope,
-                               contents=f'return {{{accessor_target}}};')
+                               contents=f'return {{{accessor_target}}};', inline=inline)
     elif dzn.semantics == RuntimeSemantics.MTS:
         # reroute mode, requires an own instance of the port
         mv_prefix = 'm_pp' if dzn.port.direction == ast.PortDirection.PROVIDES else 'm_rp'
@@ -92,39 +185,260 @@ def create_cpp_portitf(dzn: DznPortItf, scope: cpp_gen.Struct, support_files_ns:
         accessor_target = f'{member_var.name}'
         accessor_fn = Function(wrap_strict_sts,
                                f'{fn_prefix}{cap_name}', scope=scope,
-                               contents=f'return {{{accessor_target}}};')
+                               contents=f'return {{{accessor_target}}};', inline=inline)
     else:
         raise ValueError('unknown runtime semantics')
 
-    return CppPortItf(dzn, t, accessor_fn, accessor_target, member_var)
+    return CppPortItf(dzn, t, accessor_fn, accessor_target, member_var, encapsulee_port)
+
+
+def inplace_fqns(inplace_ns: NameSpaceIds) -> Tuple[Fqn, Fqn]:
+    """Get the C++ fully-qualified names of the Inplace() and InplaceShell() helpers."""
+    return (Fqn(inplace_ns + ['Inplace'], prefix_root_ns=True),
+            Fqn(inplace_ns + ['InplaceShell'], prefix_root_ns=True))
+
+
+def dispatcher_name(facilities: Facilities, rerouting: Rerouting) -> str:
+    """Get the name of the member variable via which the events are dispatched. When out-events
+    are batched, all events must pass the Event Batcher to preserve their order. Likewise all
+    events must pass the Bounded Dispatcher or the Priority Lanes when configured."""
+    if rerouting.batcher:
+        return rerouting.batcher.name
+    if rerouting.bounded_dispatcher:
+        return rerouting.bounded_dispatcher.name
+    if rerouting.priority_lanes:
+        return rerouting.priority_lanes.name
+    return facilities.dispatcher.name
+
+
+def instrument_event(rerouting: Rerouting, port_name: str, event_name: str,
+                     bypassed: bool = False) -> Tuple[str, str, str]:
+    """Create the C++ snippets to instrument a rerouted event with the Event Statistics: the
+    probe in the dispatched lambda, the init-capture of the registered counters in the port
+    lambda and the init-capture of the raise timestamp in the dispatched lambda. The bypassed
+    variant probes an event that is handled directly on the dispatcher thread (refer to
+    bypass_dispatcher). All snippets are empty when instrumentation is disabled."""
+    if rerouting.statistics is None:
+        return '', '', ''
+
+    stats = rerouting.statistics.name
+    probe = f'{stats}.Bypassed(*counters)' if bypassed else f'{stats}.Handling(*counters, raised)'
+    return (f'auto probe = {probe}; ',
+            f', counters = &{stats}.Register("{port_name}", "{event_name}")',
+            f', raised = {stats}.Raised()')
+
+
+def trace_event(rerouting: Rerouting, port: CppPortItf, event_name: str) -> Tuple[str, str, str]:
+    """Create the C++ snippets to trace a rerouted event with the Event Trace: the init-capture
+    of the registered trace point in the port lambda, the line that records the enqueue phase and
+    the probe in the dispatched lambda that records the dequeue phase. The trace point is named
+    after the shell and its port, e.g. "MyShell.api". All snippets are empty when tracing is
+    disabled."""
+    if rerouting.trace_ns is None:
+        return '', '', ''
+
+    trace = Fqn(rerouting.trace_ns + ['EventTrace'], prefix_root_ns=True)
+    phase = Fqn(rerouting.trace_ns + ['TracePhase'], prefix_root_ns=True)
+    return (f', point = {trace}::Register("{port.accessor_fn.scope.name}.{port.name}", '
+            f'"{event_name}")',
+            f'    {trace}::Record(point, {phase}::Enqueue);\n',
+            f'{trace}::Record(point, {phase}::Dequeue); ')
+
+
+def bypass_dispatcher(rerouting: Rerouting, call: str) -> str:
+    """Create the C++ line that handles a synchronous in-event directly when it is raised on the
+    dispatcher thread itself, instead of enqueueing it and blocking on its own dispatcher. The
+    call is instrumented with the bypassed variant of instrument_event. The line is empty when the
+    same-thread bypass is disabled."""
+    if rerouting.dispatcher_thread is None:
+        return ''
+
+    return f'    if ({rerouting.dispatcher_thread.name}.load(std::memory_order_relaxed) == ' \
+           f'std::this_thread::get_id()) {call}\n'
+
+
+def find_extern(port: CppPortItf, formal: ast.Formal, fc: ast.FileContents) -> ast.Extern:
+    """Find the extern type of a formal of an event of the port."""
+    ext_type = find_on_fqn(fc, formal.type_name.value, port.dzn_port_itf.interface.fqn)
+    if not isinstance(ext_type, ast.Extern):
+        raise AdvShellError(f'Extern type {formal.type_name} not found')
+    return ext_type
+
+
+def event_params(port: CppPortItf, event: ast.Event, fc: ast.FileContents) -> List[Param]:
+    """Create the C++ parameters of an event, where the formals with direction out or inout
+    are references."""
+    params = []
+    for i in event.signature.formals.elements:
+        postfix = TypePostfix.REFERENCE if i.direction != ast.FormalDirection.IN else \
+            TypePostfix.NONE
+        params.append(Param(TypeDesc(Fqn([find_extern(port, i, fc).value.value]), postfix),
+                            i.name))
+
+    return params
+
+
+def posted_captures(port: CppPortItf, event: ast.Event, fc: ast.FileContents,
+                    rerouting: Rerouting) -> Tuple[str, str, str]:
+    """Create the C++ snippets that move the (in) arguments of an event into the job that is
+    posted to the dispatcher, instead of copying them: the init-captures, the call arguments and
+    the lambda specifier. An argument of which the extern type is configured as shared buffer is
+    moved into a std::shared_ptr, so copies of the job (e.g. by the queue of the dispatcher) share
+    its payload. Each job is executed once, hence it moves the arguments into the call."""
+    captures = []
+    call_arguments = []
+    for formal in event.signature.formals.elements:
+        ext_type = find_extern(port, formal, fc)
+        if '.'.join(ext_type.fqn) in rerouting.shared_buffer_externs:
+            captures.append(f', {formal.name} = std::make_shared<{ext_type.value.value}>'
+                            f'(std::move({formal.name}))')
+            call_arguments.append(f'std::move(*{formal.name})')
+        else:
+            captures.append(f', {formal.name} = std::move({formal.name})')
+            call_arguments.append(f'std::move({formal.name})')
+
+    return ''.join(captures), ', '.join(call_arguments), '() mutable' if captures else ''
+
+
+def reroute_helper(port: CppPortItf, event: ast.Event, fc: ast.FileContents,
+                   rerouting: Rerouting, dispatch: str, dispatcher: str) -> Optional[Fqn]:
+    """Get the C++ fully-qualified name of the template of the Reroute Helpers support file that
+    reroutes the event, instead of an open-coded lambda. This applies to the plain rerouting only:
+    blocking via dzn::shell or posting to the dispatcher, without same-thread bypass and without
+    shared buffer arguments. Reply None when the event needs an open-coded lambda."""
+    helpers_ns = rerouting.reroute_helpers_ns
+    if helpers_ns is None or rerouting.statistics is not None:
+        return None
+    if dispatch == f'dzn::shell({dispatcher}, ' and rerouting.dispatcher_thread is None:
+        return Fqn(helpers_ns + ['RerouteShell'], prefix_root_ns=True)
+    if dispatch == f'{dispatcher}(' and \
+            not any('.'.join(find_extern(port, f, fc).fqn) in rerouting.shared_buffer_externs
+                    for f in event.signature.formals.elements):
+        return Fqn(helpers_ns + ['ReroutePost'], prefix_root_ns=True)
+    return None
+
+
+def check_shared_buffer_externs(selection: Set[str], fc: ast.FileContents):
+    """Check the user configured extern types (by fully qualified Dezyne name) of which the
+    arguments are passed as shared buffer. Raise an AdvShellError when one is not found."""
+    for name in sorted(selection):
+        if not isinstance(find_on_fqn(fc, name.split('.'), []), ast.Extern):
+            raise AdvShellError(f'Configured shared buffer extern "{name}" not found')
+
+
+def check_inplace_externs(selection: Set[str], fc: ast.FileContents):
+    """Check the user configured extern types (by fully qualified Dezyne name) that the zero
+    heap allocation rerouting may capture by value. Raise an AdvShellError when one is not found."""
+    for name in sorted(selection):
+        if not isinstance(find_on_fqn(fc, name.split('.'), []), ast.Extern):
+            raise AdvShellError(f'Configured inplace extern "{name}" not found')
+
+
+# C++ types that are trivially copyable and not larger than a pointer on the mainstream platforms
+INPLACE_SCALAR_TYPES = {'bool', 'char', 'signed char', 'unsigned char', 'short', 'unsigned short',
+                        'int', 'unsigned', 'unsigned int', 'long', 'unsigned long', 'float',
+                        'size_t', 'std::size_t', 'ptrdiff_t', 'std::ptrdiff_t', 'intptr_t',
+                        'std::intptr_t', 'uintptr_t', 'std::uintptr_t', 'int8_t', 'std::int8_t',
+                        'uint8_t', 'std::uint8_t', 'int16_t', 'std::int16_t', 'uint16_t',
+                        'std::uint16_t', 'int32_t', 'std::int32_t', 'uint32_t', 'std::uint32_t'}
+
+
+def inplace_captures(port: CppPortItf, event: ast.Event, fc: ast.FileContents,
+                     rerouting: Rerouting) -> str:
+    """Create the C++ snippet that captures the (in) arguments of an event by value into the job
+    that is posted to the dispatcher without heap allocation. The job must fit the small buffer of
+    std::function of two pointers (refer to the Inplace Callable support file), of which the
+    captured 'this' takes one. Hence at most one argument is captured, of which the extern type
+    must be a known scalar type or be configured as inplace extern. Raise an AdvShellError naming
+    the event otherwise, instead of generating C++ code that fails its static_assert."""
+    formals = event.signature.formals.elements
+    event_name = f'{port.name}.{event.name}'
+    if len(formals) > 1:
+        raise AdvShellError(f'Event {event_name} can not be rerouted free of heap allocations: '
+                            f'its {len(formals)} arguments exceed the small buffer')
+    for formal in formals:
+        ext_type = find_extern(port, formal, fc)
+        if ext_type.value.value not in INPLACE_SCALAR_TYPES and \
+                '.'.join(ext_type.fqn) not in rerouting.inplace_externs:
+            raise AdvShellError(f'Event {event_name} can not be rerouted free of heap allocations: '
+                                f'argument {formal.name} of extern type {".".join(ext_type.fqn)} '
+                                'is not configured as inplace extern')
+
+    return ''.join(f', {x.name}' for x in formals)
 
 
 def reroute_in_events(port: CppPortItf, facilities: Facilities, encapsulee: CppEncapsulee,
-                      fc: ast.FileContents) -> str:
+                      fc: ast.FileContents, rerouting: Rerouting) -> str:
+    """Create C++ code to reroute in events. By default an in-event blocks the caller until
+    the dispatcher has handled it (dzn::shell). Selected in-events that are eligible are posted
+    asynchronously instead (fire-and-forget), of which the arguments are moved into the posted job
+    (refer to posted_captures). When the namespace of the Inplace Callable support file is
+    specified, the rerouting is generated free of heap allocations. When the namespace of the
+    Reroute Helpers support file is specified, the plain rerouting is a shared template helper
+    (refer to reroute_helper)."""
+    dispatcher = dispatcher_name(facilities, rerouting)
     result = []
     for event in [e for e in port.dzn_port_itf.interface.events.elements if
                   e.direction == ast.EventDirection.IN]:
         in_formals = [f for f in event.signature.formals.elements if
                       f.direction == ast.FormalDirection.IN]
 
-        args = []
-        for i in event.signature.formals.elements:
-            ext_type = find_on_fqn(fc, i.type_name.value, port.dzn_port_itf.interface.fqn)
-            if not isinstance(ext_type, ast.Extern):
-                raise AdvShellError(f'Extern type {i.type_name} not found')
-
-            opt_ref = '&' if i.direction != ast.FormalDirection.IN else ''
-            args.append(f'{ext_type.value.value}{opt_ref} {i.name}')
-
+        args = [p.as_def for p in event_params(port, event, fc)]
         captures_by_value = ''.join(f', {x.name}' for x in in_formals)
         stdfunction_arguments = '(' + ', '.join(args) + ')' if args else ''
         call_arguments = ', '.join([arg.name for arg in event.signature.formals.elements])
 
-        txt = f'{port.accessor_target}.in.{event.name} = [&]{stdfunction_arguments} {{\n' \
-              f'    return dzn::shell({facilities.dispatcher.name}, [&{captures_by_value}] ' \
-              f'{{ return {encapsulee.member_var.name}.{port.name}.in.{event.name}' \
-              f'({call_arguments}); }});\n' \
-              '};'
+        is_async = rerouting.async_in_events.match(port.name, event.name) and \
+            is_async_in_event_eligible(event)
+        is_priority = rerouting.priority_lanes is not None and \
+            rerouting.priority_events.match(port.name, event.name)
+        probe, counters, raised = instrument_event(rerouting, port.name, event.name)
+        bypassed_probe, _, _ = instrument_event(rerouting, port.name, event.name, bypassed=True)
+        point, enqueue, dequeue = trace_event(rerouting, port, event.name)
+        probe = dequeue + probe
+        call = f'{{ {probe}return {port.encapsulee_port}.in.{event.name}' \
+               f'({call_arguments}); }}'
+        bypassed_call = f'{{ {dequeue}{bypassed_probe}return {port.encapsulee_port}.in.' \
+                        f'{event.name}({call_arguments}); }}'
+        bypass = bypass_dispatcher(rerouting, bypassed_call) if not is_async else ''
+
+        if rerouting.inplace_ns is None:
+            captures, specifier = (captures_by_value, '')
+            if is_async:
+                dispatch = f'{dispatcher}.Priority(' if is_priority else f'{dispatcher}('
+                captures, moved_arguments, specifier = posted_captures(port, event, fc, rerouting)
+                call = f'{{ {probe}return {port.encapsulee_port}.in.{event.name}' \
+                       f'({moved_arguments}); }}'
+            elif is_priority:
+                dispatch = f'{dispatcher}.PriorityShell('
+            elif rerouting.batcher or rerouting.bounded_dispatcher or rerouting.priority_lanes:
+                dispatch = f'{dispatcher}.Shell('
+            else:
+                dispatch = f'dzn::shell({dispatcher}, '
+            helper = reroute_helper(port, event, fc, rerouting, dispatch, dispatcher)
+            if helper:
+                txt = f'{port.accessor_target}.in.{event.name} = ' \
+                      f'{helper}({dispatcher}, {port.encapsulee_port}.in.{event.name});'
+            else:
+                txt = f'{port.accessor_target}.in.{event.name} = ' \
+                      f'[&{counters}{point}]{stdfunction_arguments} {{\n' \
+                      f'{enqueue}' \
+                      f'{bypass}' \
+                      f'    return {dispatch}[&{captures}{raised}{", point" if point else ""}]' \
+                      f'{specifier} {call});\n' \
+                      '};'
+        else:
+            inplace, inplace_shell = inplace_fqns(rerouting.inplace_ns)
+            if is_async:
+                captures_by_value = inplace_captures(port, event, fc, rerouting)
+                dispatch = f'{dispatcher}({inplace}([this{captures_by_value}] {call}))'
+            else:
+                dispatch = f'{inplace_shell}({dispatcher}, [&] {call})'
+            txt = f'{port.accessor_target}.in.{event.name} = ' \
+                  f'{inplace}([this]{stdfunction_arguments} {{\n' \
+                  f'{bypass}' \
+                  f'    return {dispatch};\n' \
+                  '});'
 
         result.append(txt)
 
@@ -132,44 +446,118 @@ def reroute_in_events(port: CppPortItf, facilities: Facilities, encapsulee: CppE
 
 
 def reroute_out_events(port: CppPortItf, facilities: Facilities, encapsulee: CppEncapsulee,
-                       fc: ast.FileContents) -> str:
-    """Create C++ code to reroute out events."""
+                       fc: ast.FileContents, rerouting: Rerouting) -> str:
+    """Create C++ code to reroute out events, of which the arguments are moved into the posted
+    job (refer to posted_captures). Selected out-events are batched by the Event Batcher. When the
+    namespace of the Inplace Callable support file is specified, the rerouting is generated free
+    of heap allocations (refer to inplace_captures). When the namespace of the Reroute Helpers
+    support file is specified, the plain rerouting is a shared template helper (refer to
+    reroute_helper)."""
+    dispatcher = dispatcher_name(facilities, rerouting)
     result = []
     for event in [e for e in port.dzn_port_itf.interface.events.elements if
                   e.direction == ast.EventDirection.OUT]:
         if [f for f in event.signature.formals.elements if
             f.direction == ast.FormalDirection.OUT]:
             raise AdvShellError('Out events can not have out parameter argument')
-        in_formals = [f for f in event.signature.formals.elements if
-                      f.direction == ast.FormalDirection.IN]
-
-        args = []
-        for i in event.signature.formals.elements:
-            ext_type = find_on_fqn(fc, i.type_name.value, port.dzn_port_itf.interface.fqn)
-            if not isinstance(ext_type, ast.Extern):
-                raise AdvShellError(f'Extern type {i.type_name} not found')
 
-            args.append(f'{ext_type.value.value} {i.name}')
-
-        captures_by_value = ''.join(f', {x.name}' for x in in_formals)
+        args = [p.as_def for p in event_params(port, event, fc)]
         stdfunction_arguments = '(' + ', '.join(args) + ')' if args else ''
         call_arguments = ', '.join([arg.name for arg in event.signature.formals.elements])
 
-        txt = f'{port.accessor_target}.out.{event.name} = [&]{stdfunction_arguments} {{\n' \
-              f'    return {facilities.dispatcher.name}([&{captures_by_value}] ' \
-              f'{{ return {encapsulee.member_var.name}.{port.name}.out.{event.name}' \
-              f'({call_arguments}); }});\n' \
-              '};'
+        is_batched = rerouting.batched_out_events.match(port.name, event.name)
+        is_priority = rerouting.priority_lanes is not None and \
+            rerouting.priority_events.match(port.name, event.name)
+        if is_batched:
+            post = f'{dispatcher}.Batch('
+        elif is_priority:
+            post = f'{dispatcher}.Priority('
+        else:
+            post = f'{dispatcher}('
+        probe, counters, raised = instrument_event(rerouting, port.name, event.name)
+        point, enqueue, dequeue = trace_event(rerouting, port, event.name)
+        probe = dequeue + probe
+        call = f'{{ {probe}return {port.encapsulee_port}.out.{event.name}' \
+               f'({call_arguments}); }}'
+
+        if rerouting.inplace_ns is None:
+            captures, moved_arguments, specifier = posted_captures(port, event, fc, rerouting)
+            call = f'{{ {probe}return {port.encapsulee_port}.out.{event.name}' \
+                   f'({moved_arguments}); }}'
+            helper = reroute_helper(port, event, fc, rerouting, post, dispatcher)
+            if helper:
+                txt = f'{port.accessor_target}.out.{event.name} = ' \
+                      f'{helper}({dispatcher}, {port.encapsulee_port}.out.{event.name});'
+            else:
+                txt = f'{port.accessor_target}.out.{event.name} = ' \
+                      f'[&{counters}{point}]{stdfunction_arguments} {{\n' \
+                      f'{enqueue}' \
+                      f'    return {post}[&{captures}{raised}{", point" if point else ""}]' \
+                      f'{specifier} {call});\n' \
+                      '};'
+        else:
+            inplace, _ = inplace_fqns(rerouting.inplace_ns)
+            captures_by_value = inplace_captures(port, event, fc, rerouting)
+            txt = f'{port.accessor_target}.out.{event.name} = ' \
+                  f'{inplace}([this]{stdfunction_arguments} {{\n' \
+                  f'    return {post}{inplace}([this{captures_by_value}] {call}));\n' \
+                  '});'
 
         result.append(txt)
 
     return str(TextBlock(result)) if result else None
 
 
+def create_awaitable_port(port: CppPortItf, scope: cpp_gen.Struct, awaitable_ns: NameSpaceIds,
+                          dispatcher: str, fc: ast.FileContents,
+                          inline: bool = False) -> CppAwaitablePort:
+    """Create C++ code for the awaitable variant of the in-events of a provides port (MTS): a
+    nested struct with a function per in-event that replies a C++20 awaitable, which posts the
+    in-event to the dispatcher and resumes the awaiting coroutine with the reply. The in-formals
+    are captured by value, the out-formals by reference (the awaiting coroutine is suspended).
+    The accessor optionally takes the resumer of the awaiting coroutine, that defaults to resuming
+    on the dispatcher thread (refer to the Awaitable support file). The definitions are inline
+    when specified (e.g. header-only)."""
+    cap_name = port.name[0].upper() + port.name[1:]
+    nested_t = TypeDesc(Fqn([scope.name, f'Async{cap_name}']))
+    shell_mv = cpp_gen.decl_var_ptr_t(Fqn([scope.name]), 'm_shell')
+    resumer_fqn = awaitable_ns + ['AwaitableResumer']
+    resumer_mv = cpp_gen.decl_var_t(Fqn(resumer_fqn, True), 'm_resumer')
+    resumer_param = Param(TypeDesc(Fqn(resumer_fqn, True), default_value='nullptr'), 'resumer')
+    nested_scope = cpp_gen.Struct(name=str(nested_t.fqn))
+
+    event_fns = []
+    for event in [e for e in port.dzn_port_itf.interface.events.elements if
+                  e.direction == ast.EventDirection.IN]:
+        params = event_params(port, event, fc)
+        captures = ''.join(f', {"" if f.direction == ast.FormalDirection.IN else "&"}{f.name}'
+                           for f in event.signature.formals.elements)
+        call_arguments = ', '.join([f.name for f in event.signature.formals.elements])
+        return_t = TypeDesc(Fqn(awaitable_ns + [f'Awaitable<decltype({port.type}::in.'
+                                                f'{event.name})::result_type>'], True))
+        event_fns.append(Function(return_t, event.name, scope=nested_scope, params=params,
+                                  contents=f'return {{{shell_mv.name}->{dispatcher}, '
+                                           f'[shell = {shell_mv.name}{captures}] {{ return '
+                                           f'shell->{port.encapsulee_port}.in.{event.name}'
+                                           f'({call_arguments}); }}, {resumer_mv.name}}};',
+                                  inline=inline))
+
+    struct = cpp_gen.Struct(name=f'Async{cap_name}',
+                            contents=TextBlock([[fn.as_decl for fn in event_fns],
+                                                str(shell_mv), str(resumer_mv)]).indent())
+    accessor_fn = Function(nested_t, f'AsyncProvides{cap_name}', scope=scope,
+                           params=[resumer_param],
+                           contents=f'return {{this, std::move({resumer_param.name})}};',
+                           inline=inline)
+    return CppAwaitablePort(port, struct, accessor_fn, event_fns)
+
+
 def create_constructor(scope, facilities: Facilities, encapsulee: CppEncapsulee,
                        provides_ports: CppPorts, requires_ports: CppPorts,
-                       fc: ast.FileContents) -> Constructor:
-    """Create C++ code for the constructor"""
+                       fc: ast.FileContents, rerouting: Rerouting,
+                       inline: bool = False) -> Constructor:
+    """Create C++ code for the constructor, of which the definition is inline when specified
+    (e.g. header-only)."""
 
     # populate the member initialization list (mil)
     # -------------------------------------
@@ -179,91 +567,158 @@ def create_constructor(scope, facilities: Facilities, encapsulee: CppEncapsulee,
         p_locator = const_param_ref_t(['dzn', 'locator'], 'prototypeLocator')
         mil = [f'{facilities.locator.name}(std::move(FacilitiesCheck({p_locator.name}).clone()'
                f'.set({facilities.runtime.name})'
-               f'.set({facilities.dispatcher.name})))',
-               f'{encapsulee.member_var.name}({facilities.locator.name})']
+               f'.set({facilities.dispatcher.name})))']
+        encapsulee_arg = facilities.locator.name
     elif facilities.origin == FacilitiesOrigin.IMPORT:
         p_locator = const_param_ref_t(['dzn', 'locator'], 'locator')
-        mil = [f'{facilities.dispatcher.name}(FacilitiesCheck({p_locator.name}).get<dzn::pump>())',
-               f'{encapsulee.member_var.name}({p_locator.name})']
+        mil = [f'{facilities.dispatcher.name}(FacilitiesCheck({p_locator.name}).get<dzn::pump>())']
+        encapsulee_arg = p_locator.name
     else:
         raise AdvShellError(f'Invalid argument "origin: " {facilities.origin}')
 
+    # construct the event batcher (optional) with the dispatcher, and the encapsulee
+    if rerouting.batcher:
+        mil.append(f'{rerouting.batcher.name}({facilities.dispatcher.name}, '
+                   f'{rerouting.batch_flush})')
+    if rerouting.dispatcher_thread:
+        mil.append(f'{rerouting.dispatcher_thread.name}(std::thread::id())')
+    if rerouting.bounded_dispatcher:
+        mil.append(f'{rerouting.bounded_dispatcher.name}({facilities.dispatcher.name}, '
+                   f'{rerouting.dispatcher_capacity}, {rerouting.dispatcher_overflow})')
+    if rerouting.priority_lanes:
+        mil.append(f'{rerouting.priority_lanes.name}({facilities.dispatcher.name})')
+    mil.append(f'{encapsulee.member_var.name}({encapsulee_arg})')
+
     p_shell_name = const_param_ref_t(['std', 'string'], 'encapsuleeInstanceName', '""')
 
     # construct the (MTS) boundary ports
     mts_pp, mts_rp = (provides_ports.mts_ports, requires_ports.mts_ports)
-    mil.extend([f'{p.member_var.name}({encapsulee.member_var.name}.{p.name})' for p in mts_pp])
-    mil.extend([f'{p.member_var.name}({encapsulee.member_var.name}.{p.name})' for p in mts_rp])
+    mil.extend([f'{p.member_var.name}({p.encapsulee_port})' for p in mts_pp])
+    mil.extend([f'{p.member_var.name}({p.encapsulee_port})' for p in mts_rp])
 
     # populate the definition of the constructor
     # ------------------------------------------
     encapsulee_mv = encapsulee.member_var.name
-    rerouted_in_events = flatten_to_strlist([reroute_in_events(p, facilities, encapsulee, fc)
+    rerouted_in_events = flatten_to_strlist([reroute_in_events(p, facilities, encapsulee, fc,
+                                                               rerouting)
                                              for p in mts_pp])
-    rerouted_out_events = flatten_to_strlist([reroute_out_events(p, facilities, encapsulee, fc)
+    rerouted_out_events = flatten_to_strlist([reroute_out_events(p, facilities, encapsulee, fc,
+                                                                 rerouting)
                                               for p in mts_rp])
 
     contents = TextBlock([
         Comment('Complete the component meta info of the encapsulee and its ports that '
                 'are configured for MTS'),
         f'{encapsulee_mv}.dzn_meta.name = {p_shell_name.name};',
-        [f'{encapsulee_mv}.{p.name}.meta.require.name = "{p.name}";' for p in mts_pp],
-        [f'{encapsulee_mv}.{p.name}.meta.provide.name = "{p.name}";' for p in mts_rp],
+        [f'{p.encapsulee_port}.meta.require.name = "{p.name}";' for p in mts_pp],
+        [f'{p.encapsulee_port}.meta.provide.name = "{p.name}";' for p in mts_rp],
         BLANK_LINE,
         Comment('Reroute in-events of boundary provides ports (MTS) via the dispatcher'),
         rerouted_in_events if rerouted_in_events else Comment('<None>'),
         BLANK_LINE,
         Comment('Reroute out-events of boundary requires ports (MTS) via the dispatcher'),
         rerouted_out_events if rerouted_out_events else Comment('<None>'),
+        [BLANK_LINE,
+         Comment('Record the dispatcher thread, in-events raised on it bypass the dispatcher '
+                 '(until handled, all in-events are dispatched)'),
+         f'{facilities.dispatcher.name}([this] {{ {rerouting.dispatcher_thread.name}.store('
+         f'std::this_thread::get_id(), std::memory_order_relaxed); }});']
+        if rerouting.dispatcher_thread else None,
     ])
 
     return Constructor(scope, params=[p_locator, p_shell_name],
-                       member_initlist=mil, contents=str(contents))
+                       member_initlist=mil, contents=str(contents), inline=inline)
+
+
+def create_flush_out_events_fn(scope: cpp_gen.Struct, batcher: MemberVariable,
+                               inline: bool = False) -> Function:
+    """Create c++ code for the FlushOutEvents() method that posts the pending batch of
+    out-events to the dispatcher."""
+    return Function(return_type=void_t(), name='FlushOutEvents', scope=scope,
+                    contents=f'{batcher.name}.Flush();', inline=inline)
+
+
+def create_dispatcher_queue_fn(scope: cpp_gen.Struct, bounded_dispatcher: MemberVariable,
+                               inline: bool = False) -> Function:
+    """Create c++ code for the DispatcherQueue() method that provides the Bounded Dispatcher,
+    e.g. to observe the number of dropped or rejected events."""
+    return Function(return_type=TypeDesc(bounded_dispatcher.type.fqn, TypePostfix.REFERENCE,
+                                         const=True),
+                    name='DispatcherQueue', scope=scope, cv='const',
+                    contents=f'return {bounded_dispatcher.name};', inline=inline)
+
+
+def create_statistics_fn(scope: cpp_gen.Struct, statistics: MemberVariable,
+                         inline: bool = False) -> Function:
+    """Create c++ code for the Statistics() accessor of the Event Statistics."""
+    return Function(return_type=TypeDesc(statistics.type.fqn, TypePostfix.REFERENCE, const=True),
+                    name='Statistics', scope=scope, cv='const',
+                    contents=f'return {statistics.name};', inline=inline)
 
 
 def create_final_construct_fn(scope: cpp_gen.Struct, provides_ports: CppPorts,
-                              requires_ports: CppPorts, encapsulee: CppEncapsulee) -> Function:
-    """Create c++ code for the FinalConstruct method."""
+                              requires_ports: CppPorts, encapsulee: CppEncapsulee,
+                              compile_time_wiring: bool = False, inline: bool = False) -> Function:
+    """Create c++ code for the FinalConstruct method. With compile-time wiring, the port types of
+    the encapsulee are statically asserted against the generated boundary ports, the functors
+    are moved instead of copied and the runtime bindings check of the encapsulee itself is
+    skipped, since all its ports are either checked boundary ports or wired by Dezyne."""
     param = const_param_ptr_t(['dzn', 'meta'], 'parentComponentMeta', 'nullptr')
     fn = Function(return_type=void_t(), name='FinalConstruct',
-                  scope=scope, params=[param])
+                  scope=scope, params=[param], inline=inline)
 
     all_pp, mts_pp = (provides_ports.ports, provides_ports.mts_ports)
     all_rp, mts_rp = (requires_ports.ports, requires_ports.mts_ports)
     encapsulee_mv = encapsulee.member_var.name
 
+    def transfer(target: str, source: str) -> str:
+        return f'{target} = std::move({source});' if compile_time_wiring else \
+            f'{target} = {source};'
+
+    transfer_verb = 'Move' if compile_time_wiring else 'Copy'
+
     fn.contents = TextBlock([
+        [Comment('Check at compile-time that the ports of the encapsulated component match the '
+                 'generated boundary ports'),
+         [f'static_assert(std::is_same<decltype({p.encapsulee_port}), {p.type}>::value, '
+          f'"Port {p.name} of the encapsulee mismatches, regenerate the Advanced Shell");'
+          for p in all_pp + all_rp],
+         BLANK_LINE] if compile_time_wiring else None,
+
         Comment('Check the bindings of all boundary ports'),
         [f'{p.accessor_target}.check_bindings();' for p in all_pp],
         [f'{p.accessor_target}.check_bindings();' for p in all_rp],
         BLANK_LINE,
 
-        Comment('Copy the out-functors of the boundary provides-ports (MTS) to the '
+        Comment(f'{transfer_verb} the out-functors of the boundary provides-ports (MTS) to the '
                 'respective ports of the encapsulated component'),
-        [f'{encapsulee_mv}.{p.name}.out = {p.accessor_target}.out;'
+        [transfer(f'{p.encapsulee_port}.out', f'{p.accessor_target}.out')
          for p in mts_pp] if mts_pp else Comment('<none>'),
         BLANK_LINE,
 
-        Comment('Copy the in-functors of the boundary requires-ports (MTS) to the '
+        Comment(f'{transfer_verb} the in-functors of the boundary requires-ports (MTS) to the '
                 'respective ports of the encapsulated component'),
-        [f'{encapsulee_mv}.{p.name}.in = {p.accessor_target}.in;'
+        [transfer(f'{p.encapsulee_port}.in', f'{p.accessor_target}.in')
          for p in mts_rp] if mts_rp else Comment('<none>'),
         BLANK_LINE,
 
-        Comment('Complete the encapsulated component meta information and check the bindings '
-                'of all encapsulee ports'),
-        f'{encapsulee_mv}.dzn_meta.parent = {param.name};',
-        f'{encapsulee_mv}.check_bindings();',
+        [Comment('Complete the encapsulated component meta information (its ports are all wired '
+                 'and checked above)'),
+         f'{encapsulee_mv}.dzn_meta.parent = {param.name};'] if compile_time_wiring else
+        [Comment('Complete the encapsulated component meta information and check the bindings '
+                 'of all encapsulee ports'),
+         f'{encapsulee_mv}.dzn_meta.parent = {param.name};',
+         f'{encapsulee_mv}.check_bindings();'],
     ])
     return fn
 
 
-def create_facilities_check_fn(scope: cpp_gen.Struct,
-                               facilities_origin: FacilitiesOrigin) -> Function:
+def create_facilities_check_fn(scope: cpp_gen.Struct, facilities_origin: FacilitiesOrigin,
+                               inline: bool = False) -> Function:
     """Create c++ code for the FacilitiesCheck() method."""
     param = const_param_ref_t(['dzn', 'locator'], 'locator')
     fn = Function(return_type=param.type_desc, name='FacilitiesCheck', params=[param],
-                  prefix=FunctionPrefix.STATIC, scope=scope)
+                  prefix=FunctionPrefix.STATIC, scope=scope, inline=inline)
 
     if facilities_origin == FacilitiesOrigin.CREATE:
         fn.contents = TextBlock([
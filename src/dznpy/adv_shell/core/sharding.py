@@ -0,0 +1,217 @@
+"""
+Module implementing the processing of an Advanced Shell of which the encapsulated system is split
+in shards: the groups of instances that share no bindings with each other. Each shard runs on its
+own dispatcher (thread) and Dezyne runtime, hence independent parts of a system scale across cores.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+from typing import Dict, List, Tuple
+
+# dznpy modules
+from ... import cpp_gen, ast, ast_view
+from ...ast_view import find_on_fqn
+from ...code_gen_common import BLANK_LINE
+from ...cpp_gen import Comment, Constructor, Function, Fqn, TypeDesc, TypePostfix, \
+    const_param_ref_t, const_param_ptr_t, void_t
+from ...misc_utils import flatten_to_strlist, TextBlock
+
+# own modules
+from ..common import Configuration, CppPorts, CppShard, DznElements, Facilities, \
+    FacilitiesOrigin, Rerouting
+from ..types import AdvShellError
+from .processing import reroute_in_events, reroute_out_events
+
+
+def check_sharding(cfg: Configuration, dzn_elements: DznElements):
+    """Check whether the user configuration allows to shard the encapsulee. Raise an
+    AdvShellError when it does not."""
+    if not isinstance(dzn_elements.encapsulee, ast.System):
+        raise AdvShellError('Only a system component can be sharded')
+    if cfg.facilities_origin != FacilitiesOrigin.CREATE:
+        raise AdvShellError('Sharding requires the facilities to be created, one dispatcher and '
+                            'runtime per shard')
+    if cfg.instrumentation or cfg.compile_time_wiring or cfg.same_thread_bypass or \
+            cfg.dispatcher_capacity or cfg.batched_out_events.is_not_empty() or \
+            cfg.priority_events.is_not_empty():
+        raise AdvShellError('Sharding can not be combined with instrumentation, compile-time '
+                            'wiring, same-thread bypass, a bounded dispatcher, batched out-events '
+                            'or priority events')
+
+
+def create_shard_facilities(scope: cpp_gen.Struct, nr: int, inline: bool = False) -> Facilities:
+    """Create the facilities of a shard, being the same as created by
+    processing.create_facilities() but with names suffixed by the shard number."""
+    dispatcher_mv = cpp_gen.decl_var_t(Fqn(['dzn', 'pump']), f'm_dispatcher{nr}')
+    runtime_mv = cpp_gen.decl_var_t(Fqn(['dzn', 'runtime']), f'm_runtime{nr}')
+    locator_mv = cpp_gen.decl_var_t(Fqn(['dzn', 'locator']), f'm_locator{nr}')
+    locator_accessor_fn = Function(TypeDesc(locator_mv.type.fqn, TypePostfix.REFERENCE),
+                                   f'Locator{nr}', scope=scope,
+                                   contents=f'return {locator_mv.name};', inline=inline)
+
+    return Facilities(FacilitiesOrigin.CREATE, dispatcher_mv, runtime_mv, locator_mv,
+                      locator_accessor_fn)
+
+
+def create_shards(scope: cpp_gen.Struct, dzn_elements: DznElements,
+                  inline: bool = False) -> List[CppShard]:
+    """Create the C++ shards of the encapsulated system (refer to ast_view.find_shards), where the
+    instances become member variables of the shell, named after the instance."""
+    system = dzn_elements.encapsulee
+    try:
+        dzn_shards = ast_view.find_shards(system)
+    except ValueError as exc:
+        raise AdvShellError(f'System {system.name} can not be sharded: {exc}') from exc
+
+    result = []
+    for nr, dzn_shard in enumerate(dzn_shards, start=1):
+        instances = [cpp_gen.decl_var_t(Fqn(find_component(dzn_elements, x).fqn, True),
+                                        f'm_{x.name}') for x in dzn_shard.instances]
+        result.append(CppShard(nr, dzn_shard, create_shard_facilities(scope, nr, inline),
+                               instances))
+    return result
+
+
+def find_component(dzn_elements: DznElements, instance: ast.Instance):
+    """Find the component (or system or foreign component) of an instance of the encapsulee."""
+    component = find_on_fqn(dzn_elements.file_contents, instance.type_name.value,
+                            dzn_elements.scope_fqn.ns_ids)
+    if component is None:
+        raise AdvShellError(f'Component {instance.type_name} of instance "{instance.name}" '
+                            'not found')
+    return component
+
+
+def find_boundary(dzn_elements: DznElements, shards: List[CppShard]) \
+        -> Dict[str, Tuple[CppShard, str]]:
+    """Find per boundary port of the encapsulated system its shard and the C++ expression of the
+    respective port of the instance it is bound to."""
+    result = {}
+    for shard in shards:
+        for port_name, endpoint in shard.dzn_shard.boundary.items():
+            result[port_name] = (shard, f'm_{endpoint.instance_name}.{endpoint.port_name}')
+
+    for port in dzn_elements.provides_ports + dzn_elements.requires_ports:
+        if port.port.name not in result:
+            raise AdvShellError(f'Boundary port "{port.port.name}" is not bound to an instance')
+    return result
+
+
+def create_connects(dzn_elements: DznElements, shards: List[CppShard]) -> List[str]:
+    """Create the C++ code to connect the internal ports of the instances (like the constructor
+    of a Dezyne system does), where dzn::connect() takes the provides port first."""
+    instances = {x.name: x for x in dzn_elements.encapsulee.instances.elements}
+
+    def is_provides(endpoint: ast.EndPoint) -> bool:
+        component = find_component(dzn_elements, instances[endpoint.instance_name])
+        port = next((p for p in component.ports.elements if p.name == endpoint.port_name), None)
+        if port is None:
+            raise AdvShellError(f'Port "{endpoint.port_name}" of instance '
+                                f'"{endpoint.instance_name}" not found')
+        return port.direction == ast.PortDirection.PROVIDES
+
+    result = []
+    for shard in shards:
+        for binding in shard.dzn_shard.bindings:
+            provided, required = (binding.left, binding.right) if is_provides(binding.left) else \
+                (binding.right, binding.left)
+            result.append(f'dzn::connect(m_{provided.instance_name}.{provided.port_name}, '
+                          f'm_{required.instance_name}.{required.port_name});')
+    return result
+
+
+def create_sharded_constructor(scope, shards: List[CppShard],
+                               boundary: Dict[str, Tuple[CppShard, str]],
+                               dzn_elements: DznElements, provides_ports: CppPorts,
+                               requires_ports: CppPorts, rerouting: Rerouting,
+                               inline: bool = False) -> Constructor:
+    """Create C++ code for the constructor of a sharded shell, where the in-events and out-events
+    of each boundary port are rerouted via the dispatcher of its shard."""
+    p_locator = const_param_ref_t(['dzn', 'locator'], 'prototypeLocator')
+    p_shell_name = const_param_ref_t(['std', 'string'], 'encapsuleeInstanceName', '""')
+
+    # create the facilities of each shard, construct the instances with the locator of their shard
+    mil = [f'{s.facilities.locator.name}(std::move(FacilitiesCheck({p_locator.name}).clone()'
+           f'.set({s.facilities.runtime.name})'
+           f'.set({s.facilities.dispatcher.name})))' for s in shards]
+    for shard in shards:
+        mil.extend([f'{mv.name}({shard.facilities.locator.name})' for mv in shard.instances])
+
+    # construct the (MTS) boundary ports
+    mts_pp, mts_rp = (provides_ports.mts_ports, requires_ports.mts_ports)
+    mil.extend([f'{p.member_var.name}({p.encapsulee_port})' for p in mts_pp])
+    mil.extend([f'{p.member_var.name}({p.encapsulee_port})' for p in mts_rp])
+
+    def reroute(ports, reroute_fn) -> List[str]:
+        return flatten_to_strlist([reroute_fn(p, boundary[p.name][0].facilities, None,
+                                              dzn_elements.file_contents, rerouting)
+                                   for p in ports])
+
+    rerouted_in_events = reroute(mts_pp, reroute_in_events)
+    rerouted_out_events = reroute(mts_rp, reroute_out_events)
+    connects = create_connects(dzn_elements, shards)
+
+    contents = TextBlock([
+        Comment('Complete the component meta info of the instances and their ports that are '
+                'configured for MTS'),
+        f'const std::string prefix = {p_shell_name.name}.empty() ? "" : '
+        f'{p_shell_name.name} + ".";',
+        [[f'{mv.name}.dzn_meta.name = prefix + "{name}";' for mv, name in
+          zip(s.instances, s.instance_names)] for s in shards],
+        [f'{p.encapsulee_port}.meta.require.name = "{p.name}";' for p in mts_pp],
+        [f'{p.encapsulee_port}.meta.provide.name = "{p.name}";' for p in mts_rp],
+        BLANK_LINE,
+        Comment('Connect the internal ports of the instances (within their shard)'),
+        connects if connects else Comment('<None>'),
+        BLANK_LINE,
+        Comment('Reroute in-events of boundary provides ports (MTS) via the dispatcher of their '
+                'shard'),
+        rerouted_in_events if rerouted_in_events else Comment('<None>'),
+        BLANK_LINE,
+        Comment('Reroute out-events of boundary requires ports (MTS) via the dispatcher of their '
+                'shard'),
+        rerouted_out_events if rerouted_out_events else Comment('<None>'),
+    ])
+
+    return Constructor(scope, params=[p_locator, p_shell_name],
+                       member_initlist=mil, contents=str(contents), inline=inline)
+
+
+def create_sharded_final_construct_fn(scope: cpp_gen.Struct, shards: List[CppShard],
+                                      provides_ports: CppPorts,
+                                      requires_ports: CppPorts, inline: bool = False) -> Function:
+    """Create c++ code for the FinalConstruct method of a sharded shell."""
+    param = const_param_ptr_t(['dzn', 'meta'], 'parentComponentMeta', 'nullptr')
+    fn = Function(return_type=void_t(), name='FinalConstruct',
+                  scope=scope, params=[param], inline=inline)
+
+    all_pp, mts_pp = (provides_ports.ports, provides_ports.mts_ports)
+    all_rp, mts_rp = (requires_ports.ports, requires_ports.mts_ports)
+    instances = [mv.name for s in shards for mv in s.instances]
+
+    fn.contents = TextBlock([
+        Comment('Check the bindings of all boundary ports'),
+        [f'{p.accessor_target}.check_bindings();' for p in all_pp],
+        [f'{p.accessor_target}.check_bindings();' for p in all_rp],
+        BLANK_LINE,
+
+        Comment('Copy the out-functors of the boundary provides-ports (MTS) to the respective '
+                'ports of the instances'),
+        [f'{p.encapsulee_port}.out = {p.accessor_target}.out;'
+         for p in mts_pp] if mts_pp else Comment('<none>'),
+        BLANK_LINE,
+
+        Comment('Copy the in-functors of the boundary requires-ports (MTS) to the respective '
+                'ports of the instances'),
+        [f'{p.encapsulee_port}.in = {p.accessor_target}.in;'
+         for p in mts_rp] if mts_rp else Comment('<none>'),
+        BLANK_LINE,
+
+        Comment('Complete the meta information of the instances and check the bindings of all '
+                'their ports'),
+        [f'{mv}.dzn_meta.parent = {param.name};' for mv in instances],
+        [f'{mv}.check_bindings();' for mv in instances],
+    ])
+    return fn
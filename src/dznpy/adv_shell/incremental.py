@@ -0,0 +1,88 @@
+"""
+Module providing the input fingerprints and depfiles for incremental (re)generation of Advanced
+Shells.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import dataclasses
+import enum
+import hashlib
+import os
+from typing import Any, Dict, List
+
+# dznpy modules
+from ..ast_view import find_dependencies, find_on_fqn
+from ..code_gen_common import CodeGenResult, GeneratedContent
+from ..dznpy_version import VERSION
+from ..misc_utils import NamespaceTrail, namespaceids_t
+
+# own modules
+from .common import Configuration, target_file_basename
+from .types import AdvShellError
+
+
+@dataclasses.dataclass(frozen=True)
+class IncrementalResult:
+    """Data class containing the result of an incremental build: the generated files of the
+    (re)built shells, the input fingerprints of all shells (keyed by target file basename) to
+    provide at the next incremental build and the basenames of the rebuilt shells."""
+    result: CodeGenResult
+    fingerprints: Dict[str, str]
+    rebuilt: List[str]
+
+
+def canonical(value: Any) -> Any:
+    """Convert a value (e.g. an AST element or a configuration) recursively into a deterministic
+    representation of builtin types, where sets are sorted."""
+    if dataclasses.is_dataclass(value):
+        return [type(value).__name__] + [canonical(getattr(value, f.name))
+                                         for f in dataclasses.fields(value)]
+    if isinstance(value, (list, tuple)):
+        return [canonical(x) for x in value]
+    if isinstance(value, (set, frozenset)):
+        return sorted(canonical(x) for x in value)
+    if isinstance(value, dict):
+        return sorted([k, canonical(v)] for k, v in value.items())
+    if isinstance(value, enum.Enum):
+        return f'{type(value).__name__}.{value.name}'
+    if isinstance(value, NamespaceTrail):
+        return str(value)
+    return value
+
+
+def input_fingerprint(cfg: Configuration) -> str:
+    """Get the md5 fingerprint of all inputs of a shell: the configuration (except the AST), the
+    encapsulee with the interfaces and types it pulls in (refer to ast_view.find_dependencies)
+    and the dznpy version. Changes in other parts of the AST do not alter the fingerprint."""
+    encapsulee = find_on_fqn(cfg.ast_fc, namespaceids_t(cfg.fqn_encapsulee_name), [])
+    if encapsulee is None:
+        raise AdvShellError(f'Encapsulee {cfg.fqn_encapsulee_name} not found')
+
+    settings = [canonical(getattr(cfg, f.name)) for f in dataclasses.fields(cfg)
+                if f.name != 'ast_fc']
+    dependencies = canonical(find_dependencies(cfg.ast_fc, encapsulee).elements)
+    return hashlib.md5(repr([VERSION, settings, dependencies]).encode('utf-8')).hexdigest().lower()
+
+
+def create_depfile(cfg: Configuration, output_dir: str = '', extra_inputs: List[str] = None) \
+        -> GeneratedContent:
+    """Create a depfile (make/ninja format) named '<target file basename>.d' declaring the
+    generated headerfile and sourcefile (the latter not in header-only mode) of the shell to depend
+    on the Dezyne file, the files it imports (assumed relative to the Dezyne file) and optionally
+    extra inputs (e.g. the Dezyne JSON file or the generator script)."""
+
+    def escape(path: str) -> str:
+        return path.replace('\\', '/').replace(' ', '\\ ')
+
+    basename = target_file_basename(cfg)
+    targets = [os.path.join(output_dir, f'{basename}.{ext}') for ext in
+               (['hh'] if cfg.header_only else ['hh', 'cc'])]
+    dezyne_dir = os.path.dirname(cfg.dezyne_filename)
+    inputs = [cfg.dezyne_filename] + [os.path.join(dezyne_dir, x.name) for x in
+                                      cfg.ast_fc.imports] + (extra_inputs or [])
+    return GeneratedContent(filename=f'{basename}.d',
+                            contents=f'{" ".join(escape(x) for x in targets)}: '
+                                     f'{" ".join(escape(x) for x in dict.fromkeys(inputs))}\n')
@@ -71,6 +71,56 @@ class PortSelect:
             raise TypeError("argument port_name must not be empty")
 
 
+@dataclass(frozen=True)
+class EventSelect:
+    """Event selection with a wildcard, or with a set of explicitly named ports and/or
+    explicitly named events. An explicitly named event is denoted as '<port>.<event>'."""
+    value: PortWildcard or Set[str]
+
+    def __post_init__(self):
+        if is_strset_instance(self.value):
+            if not self.value:
+                raise AdvShellError('strset must not be empty')
+            if [x for x in self.value if x.count('.') > 1 or not all(x.split('.'))]:
+                raise AdvShellError('strset items must be formatted as "<port>" or '
+                                    '"<port>.<event>"')
+        elif isinstance(self.value, PortWildcard):
+            if self.value == PortWildcard.REMAINING:
+                raise AdvShellError('wildcard REMAINING is not supported for event selection')
+        else:
+            raise TypeError('wrong type assigned')
+
+    def __str__(self):
+        if isinstance(self.value, PortWildcard):
+            return self.value.value
+        return str(sorted(self.value))
+
+    def tryget_strset(self) -> Set[str]:
+        """Try to get the actual value as strset. An empty set is returned otherwise."""
+        return self.value if is_strset_instance(self.value) else set()
+
+    def is_not_empty(self) -> bool:
+        """Check whether the event selection is not empty, meaning it either has a strset
+        with contents or the wildcard equals 'ALL'."""
+        return is_strset_instance(self.value) or self.value == PortWildcard.ALL
+
+    def port_names(self) -> Set[str]:
+        """Get the names of all explicitly mentioned ports, including those that are part of
+        an explicitly named event."""
+        return {x.split('.')[0] for x in self.tryget_strset()}
+
+    def match(self, port_name: str, event_name: str) -> bool:
+        """Match the specified event of a port either on the wildcard 'ALL', on the explicitly
+        named port or on the explicitly named event."""
+        if isinstance(self.value, PortWildcard):
+            return self.value == PortWildcard.ALL
+        return port_name in self.value or f'{port_name}.{event_name}' in self.value
+
+    def is_explicit_event(self, port_name: str, event_name: str) -> bool:
+        """Check whether the specified event of a port has explicitly been named."""
+        return f'{port_name}.{event_name}' in self.tryget_strset()
+
+
 @dataclass(frozen=True)
 class PortsSemanticsCfg:
     """Data class that assigns single-threaded or multi-threaded runtime semantics to
@@ -8,13 +8,18 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 # system modules
 from dataclasses import dataclass, field
 import enum
-from typing import Any, List
+import sys
+from typing import Any, Dict, List, Optional, Tuple
 
 # dznpy modules
 from .misc_utils import TextBlock, NameSpaceIds, NamespaceTrail, flatten_to_strlist
 
+# The elements are slotted (no per-instance __dict__) to lower the memory of large ASTs; this
+# requires Python 3.10 or later, otherwise they are plain dataclasses.
+SLOTS = {'slots': True} if sys.version_info >= (3, 10) else {}
 
-@dataclass(frozen=True)
+
+@dataclass(frozen=True, **SLOTS)
 class ScopeName:
     """ScopeName"""
     value: NameSpaceIds
@@ -24,39 +29,39 @@ class ScopeName:
         return '.'.join(self.value)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class EndPoint:
     """EndPoint"""
     port_name: str
     instance_name: str = None  # optional
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Binding:
     """Binding"""
     left: EndPoint
     right: EndPoint
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Bindings:
     """Bindings"""
     elements: List[Binding] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Comment:
     """Comment"""
     value: str
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Data:
     """Data"""
     value: str
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Extern:
     """Extern"""
     fqn: NameSpaceIds
@@ -78,13 +83,13 @@ class EventDirection(enum.Enum):
     OUT = 'Out'
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Fields:
     """Fields"""
     elements: List[str] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Enum:
     """Enum"""
     fqn: NameSpaceIds
@@ -93,13 +98,13 @@ class Enum:
     fields: Fields
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Filename:
     """Filename"""
     name: str
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Formal:
     """Formal"""
     name: str
@@ -107,38 +112,38 @@ class Formal:
     direction: FormalDirection
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Formals:
     """Formals"""
     elements: List[Formal] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Import:
     """Import"""
     name: str
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Injected:
     """Injected"""
     value: bool
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Instance:
     """Instance"""
     name: str
     type_name: ScopeName
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Instances:
     """Instances"""
     elements: List[Instance] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Namespace:
     """Namespace"""
     scope_name: ScopeName
@@ -151,7 +156,7 @@ class PortDirection(enum.Enum):
     PROVIDES = 'Provides'
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Port:
     """Port"""
     name: str
@@ -161,20 +166,20 @@ class Port:
     injected: Injected
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Ports:
     """Ports"""
     elements: List[Port] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Range:
     """Range"""
     from_int: int
     to_int: int
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Root:
     """Root"""
     comment: Comment
@@ -182,7 +187,7 @@ class Root:
     working_dir: str
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class SubInt:
     """SubInt"""
     fqn: NameSpaceIds
@@ -191,14 +196,14 @@ class SubInt:
     range: Range
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Signature:
     """Signature"""
     type_name: ScopeName
     formals: Formals
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Event:
     """Event"""
     name: str
@@ -206,13 +211,13 @@ class Event:
     direction: EventDirection
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Events:
     """Events"""
     elements: List[Event] = field(default_factory=list)
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Types:
     """Types"""
     elements: List[Any] = field(default_factory=list)
@@ -228,7 +233,7 @@ class Types:
         return [item for item in self.elements if isinstance(item, SubInt)]
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Component:
     """Component"""
     fqn: NameSpaceIds
@@ -237,7 +242,7 @@ class Component:
     ports: Ports
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Foreign:
     """Foreign"""
     fqn: NameSpaceIds
@@ -246,7 +251,7 @@ class Foreign:
     ports: Ports
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class Interface:
     """Interface"""
     fqn: NameSpaceIds
@@ -257,7 +262,7 @@ class Interface:
     events: Events
 
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, **SLOTS)
 class System:
     """System"""
     fqn: NameSpaceIds
@@ -268,7 +273,68 @@ class System:
     bindings: Bindings
 
 
-@dataclass(frozen=True)
+def _mutating(method):
+    """Decorate a list method to count the mutation of the list."""
+    def wrapper(self, *args, **kwargs):
+        self.mutations += 1
+        return method(self, *args, **kwargs)
+    wrapper.__name__ = method.__name__
+    return wrapper
+
+
+class MutationCountingList(list):
+    """List that counts its mutations, so a cache derived of its contents can be invalidated. Unlike
+    its size, the count also changes when an element is replaced."""
+    __slots__ = ('mutations',)
+
+    def __init__(self, *args):
+        super().__init__(*args)
+        self.mutations = 0
+
+    def __reduce__(self):
+        return MutationCountingList, (list(self),)
+
+    append = _mutating(list.append)
+    extend = _mutating(list.extend)
+    insert = _mutating(list.insert)
+    pop = _mutating(list.pop)
+    remove = _mutating(list.remove)
+    clear = _mutating(list.clear)
+    sort = _mutating(list.sort)
+    reverse = _mutating(list.reverse)
+    __setitem__ = _mutating(list.__setitem__)
+    __delitem__ = _mutating(list.__delitem__)
+    __iadd__ = _mutating(list.__iadd__)
+    __imul__ = _mutating(list.__imul__)
+
+
+@dataclass(frozen=True, **SLOTS)
+class SymbolIndex:
+    """Index of the named elements of FileContents, with the signature of the mutation counts of
+    the containers it has been built of. The fqn index has a dictionary per container
+    (in order of search precedence) with the first element of each fqn. The name index maps a name
+    to all elements with that name in order of the containers and their elements."""
+    signature: Tuple[int, ...]
+    on_fqn: List[Dict[Tuple[str, ...], Any]]
+    on_name: Dict[str, List[Any]]
+
+    @staticmethod
+    def build(containers: List[list]) -> 'SymbolIndex':
+        """Build the index of the specified containers of named elements."""
+        on_fqn = []
+        on_name = {}
+        for container in containers:
+            fqn_index = {}
+            for element in container:
+                fqn_index.setdefault(tuple(element.fqn), element)
+                on_name.setdefault(element.name.value[0], []).append(element)
+            on_fqn.append(fqn_index)
+
+        return SymbolIndex(signature=tuple(c.mutations for c in containers), on_fqn=on_fqn,
+                           on_name=on_name)
+
+
+@dataclass(frozen=True, **SLOTS)
 class FileContents:
     """FileContents"""
     components: List[Component] = field(default_factory=list)
@@ -280,6 +346,31 @@ class FileContents:
     interfaces: List[Interface] = field(default_factory=list)
     subints: List[SubInt] = field(default_factory=list)
     systems: List[System] = field(default_factory=list)
+    _symbol_index: Optional[SymbolIndex] = field(default=None, init=False, repr=False,
+                                                 compare=False)
+
+    def __post_init__(self):
+        for name in ['components', 'enums', 'externs', 'foreigns', 'interfaces', 'subints',
+                     'systems']:
+            object.__setattr__(self, name, MutationCountingList(getattr(self, name)))
+
+    @property
+    def named_containers(self) -> List[list]:
+        """Get the containers of named elements in order of search precedence."""
+        return [self.components, self.enums, self.externs, self.foreigns, self.interfaces,
+                self.subints, self.systems]
+
+    @property
+    def symbol_index(self) -> SymbolIndex:
+        """Get the index of the named elements. It is built once and rebuilt when the containers
+        have been mutated since (detected by a change of their mutation counts)."""
+        containers = self.named_containers
+        index = self._symbol_index
+        if index is None or index.signature != tuple(c.mutations for c in containers):
+            index = SymbolIndex.build(containers)
+            object.__setattr__(self, '_symbol_index', index)  # cache on the frozen instance
+
+        return index
 
     def __repr__(self):
         tb = TextBlock(content=flatten_to_strlist([self.components, self.enums, self.externs,
@@ -0,0 +1,119 @@
+"""
+Module providing a persistent cache of processed Dezyne JSON ASTs.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import gc
+import hashlib
+import os
+import pickle
+import tempfile
+
+# dznpy modules
+from .ast import FileContents
+from .dznpy_version import VERSION
+from .json_ast import DznJsonAst
+
+# constants
+CACHE_FILE_EXTENSION = '.fc.pickle'
+
+
+class AstCache:
+    """Cache of the FileContents processed from Dezyne JSON files. An entry is stored in the cache
+    directory and keyed by the md5 hash of the JSON contents and the dznpy version. An unchanged
+    Dezyne JSON file is therefore only parsed once over multiple generator runs. A missing,
+    corrupt or outdated entry is a cache miss that results in (re)parsing."""
+
+    def __init__(self, cache_dir: str, verbose: bool = False):
+        self._cache_dir = cache_dir
+        self._verbose = verbose
+        self._hits = 0
+        self._misses = 0
+
+    @property
+    def cache_dir(self) -> str:
+        """Get the cache directory."""
+        return self._cache_dir
+
+    @property
+    def hits(self) -> int:
+        """Get the number of loads that were served from the cache."""
+        return self._hits
+
+    @property
+    def misses(self) -> int:
+        """Get the number of loads that required the Dezyne JSON to be parsed."""
+        return self._misses
+
+    @staticmethod
+    def cache_key(json_contents: bytes) -> str:
+        """Get the cache key of Dezyne JSON contents for the current dznpy version."""
+        md5 = hashlib.md5(json_contents)
+        md5.update(VERSION.encode('utf-8'))
+        return md5.hexdigest().lower()
+
+    def cache_filepath(self, key: str) -> str:
+        """Get the filepath of the cache entry with the specified key."""
+        return os.path.join(self._cache_dir, f'{key}{CACHE_FILE_EXTENSION}')
+
+    def log(self, message):
+        """Log a message when verbose has been enabled."""
+        if self._verbose:
+            print(message)
+
+    def load_file(self, dezyne_filepath: str) -> FileContents:
+        """Load the FileContents of a Dezyne JSON file from the cache, or parse the file and store
+        the result in the cache when it is not present."""
+        with open(dezyne_filepath, 'rb') as file:
+            json_contents = file.read()
+
+        key = self.cache_key(json_contents)
+        fc = self._read_entry(key)
+        if fc is not None:
+            self._hits += 1
+            self.log(f'AstCache: hit {key} for "{dezyne_filepath}"')
+            return fc
+
+        self._misses += 1
+        self.log(f'AstCache: miss {key} for "{dezyne_filepath}"')
+        fc = DznJsonAst(json_contents, verbose=self._verbose).process()
+        self._write_entry(key, fc)
+        return fc
+
+    def _read_entry(self, key: str) -> FileContents or None:
+        """Read a cache entry. The garbage collector is paused meanwhile, because unpickling
+        creates a large number of objects that otherwise trigger repeated useless collections."""
+        filepath = self.cache_filepath(key)
+        if not os.path.isfile(filepath):
+            return None
+
+        gc_was_enabled = gc.isenabled()
+        gc.disable()
+        try:
+            with open(filepath, 'rb') as file:
+                fc = pickle.load(file)
+        except (OSError, EOFError, pickle.UnpicklingError, AttributeError, ImportError,
+                IndexError, TypeError):
+            self.log(f'AstCache: ignoring unreadable entry "{filepath}"')
+            return None
+        finally:
+            if gc_was_enabled:
+                gc.enable()
+
+        return fc if isinstance(fc, FileContents) else None
+
+    def _write_entry(self, key: str, fc: FileContents):
+        """Write a cache entry. It is first written to a temporary file and then renamed, so
+        concurrent generator runs never read a partially written entry."""
+        os.makedirs(self._cache_dir, exist_ok=True)
+        fd, tmp_filepath = tempfile.mkstemp(dir=self._cache_dir, suffix='.tmp')
+        try:
+            with os.fdopen(fd, 'wb') as file:
+                pickle.dump(fc, file, protocol=pickle.HIGHEST_PROTOCOL)
+            os.replace(tmp_filepath, self.cache_filepath(key))
+        except BaseException:
+            os.remove(tmp_filepath)
+            raise
@@ -7,10 +7,10 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 
 # system modules
 from dataclasses import dataclass
-from typing import Any, Optional, Set
+from typing import Any, Dict, List, Optional, Set
 
 # dznpy modules
-from .ast import FileContents, PortDirection, Ports
+from .ast import Binding, EndPoint, FileContents, Instance, Interface, PortDirection, Ports, System
 from .misc_utils import NameSpaceIds, scope_resolution_order
 
 
@@ -27,13 +27,13 @@ def find_on_fqn(fc: FileContents, item_fqn: NameSpaceIds,
     None when not found. Check the return type. Note that in Dezyne each item and its
     fqn are unique."""
     resolution_order = scope_resolution_order(searchable=item_fqn, calling_scope=as_of_scope)
+    lookups = [tuple(x) for x in resolution_order]  # the keys of the fqn index, converted once
 
-    for container in [fc.components, fc.enums, fc.externs, fc.foreigns,
-                      fc.interfaces, fc.subints, fc.systems]:
-        for lookup in resolution_order:
-            for element in container:
-                if element.fqn == lookup:
-                    return element  # return early on the first found item
+    for fqn_index in fc.symbol_index.on_fqn:
+        for lookup in lookups:
+            element = fqn_index.get(lookup)
+            if element is not None:
+                return element  # return early on the first found item
 
     return None  # item not found
 
@@ -41,14 +41,7 @@ def find_on_fqn(fc: FileContents, item_fqn: NameSpaceIds,
 def find(fc: FileContents, model_name: str) -> list:
     """Find the item instance(s) identified by its name (without namespacing) in the file contents.
     Check the resulting list for found item(s) and their type."""
-    result = []
-    for container in [fc.components, fc.enums, fc.externs, fc.foreigns,
-                      fc.interfaces, fc.subints, fc.systems]:
-        for element in container:
-            if model_name == element.name.value[0]:
-                result.append(element)
-
-    return result
+    return list(fc.symbol_index.on_name.get(model_name, []))
 
 
 def get_port_names(ports: Ports) -> PortNames:
@@ -62,3 +55,94 @@ def get_port_names(ports: Ports) -> PortNames:
             requires.add(port.name)
 
     return PortNames(provides=provides, requires=requires)
+
+
+@dataclass(frozen=True)
+class Dependencies:
+    """Data class with the elements an encapsulee (system, component or foreign) pulls in via its
+    ports: the interfaces of its ports and the types (enums, externs, subints) of the return
+    values and formals of their events. Each element is listed once, in order of first use."""
+    encapsulee: Any
+    interfaces: List[Interface]
+    types: List[Any]
+
+    @property
+    def elements(self) -> List[Any]:
+        """Get the encapsulee followed by all its dependencies."""
+        return [self.encapsulee] + self.interfaces + self.types
+
+
+def find_dependencies(fc: FileContents, encapsulee: Any) -> Dependencies:
+    """Find the dependencies of the encapsulee by resolving the type names of its ports (as of the
+    scope of the encapsulee) and of their events (as of the scope of the interface). Unresolved
+    names, like the builtin types void and bool, are skipped."""
+    interfaces = []
+    types = []
+
+    def add_unique(collection: list, element: Any):
+        if element is not None and not any(x is element for x in collection):
+            collection.append(element)
+
+    for port in encapsulee.ports.elements:
+        interface = find_on_fqn(fc, port.type_name.value, encapsulee.parent_ns.fqn)
+        if not isinstance(interface, Interface):
+            continue
+        add_unique(interfaces, interface)
+        for event in interface.events.elements:
+            add_unique(types, find_on_fqn(fc, event.signature.type_name.value, interface.fqn))
+            for formal in event.signature.formals.elements:
+                add_unique(types, find_on_fqn(fc, formal.type_name.value, interface.fqn))
+
+    return Dependencies(encapsulee, interfaces, types)
+
+
+@dataclass(frozen=True)
+class Shard:
+    """Data class with an independent part of a system: the instances that are bound to each
+    other (directly or transitively), the bindings among them and the boundary ports of the
+    system that are bound to them (keyed by the boundary port name)."""
+    instances: List[Instance]
+    bindings: List[Binding]
+    boundary: Dict[str, EndPoint]
+
+
+def find_shards(system: System) -> List[Shard]:
+    """Find the independent parts of a system, being the groups of instances that share no
+    bindings with each other. The shards and their instances, bindings and boundary ports are
+    listed in order of declaration in the system."""
+    instance_names = [x.name for x in system.instances.elements]
+    root = {name: name for name in instance_names}
+
+    def find_root(name: str) -> str:
+        while root[name] != name:
+            root[name] = root[root[name]]
+            name = root[name]
+        return name
+
+    def check_instance(endpoint: EndPoint):
+        if endpoint.instance_name not in root:
+            raise ValueError(f'Binding refers to unknown instance "{endpoint.instance_name}"')
+
+    internal = []
+    boundary = []
+    for binding in system.bindings.elements:
+        left, right = binding.left, binding.right
+        if left.instance_name is not None and right.instance_name is not None:
+            check_instance(left)
+            check_instance(right)
+            root[find_root(left.instance_name)] = find_root(right.instance_name)
+            internal.append(binding)
+        elif left.instance_name is not None or right.instance_name is not None:
+            port, endpoint = (right, left) if left.instance_name is not None else (left, right)
+            check_instance(endpoint)
+            boundary.append((port.port_name, endpoint))
+
+    shards: Dict[str, Shard] = {}
+    for instance in system.instances.elements:
+        shards.setdefault(find_root(instance.name), Shard([], [], {})).instances.append(instance)
+    for binding in internal:
+        shards[find_root(binding.left.instance_name)].bindings.append(binding)
+    for port_name, endpoint in boundary:
+        shards[find_root(endpoint.instance_name)].boundary[port_name] = endpoint
+
+    return list(shards.values())
@@ -7,6 +7,7 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 
 # system modules
 import hashlib
+import os
 from dataclasses import dataclass, field
 from typing import List, Optional
 
@@ -34,8 +35,31 @@ class GeneratedContent:
         """Get the md5 hash of the contents."""
         return self._contents_hash
 
+    def write_if_changed(self, output_dir: str) -> bool:
+        """Write the contents (utf-8 encoded, without newline translation) to the designated
+        filename in the output directory, but only when the existing file differs in its md5 hash.
+        An unchanged file keeps its timestamp and thereby does not trigger rebuilds of its
+        dependents. Reply whether the file has been written."""
+        filepath = os.path.join(output_dir, self.filename)
+        if os.path.isfile(filepath):
+            with open(filepath, 'rb') as file:
+                if hashlib.md5(file.read()).hexdigest().lower() == self.contents_hash:
+                    return False
+
+        os.makedirs(output_dir, exist_ok=True)
+        tmp_filepath = f'{filepath}.tmp'
+        with open(tmp_filepath, 'wb') as file:
+            file.write(self.contents.encode('utf-8'))
+        os.replace(tmp_filepath, filepath)
+        return True
+
 
 @dataclass(frozen=True)
 class CodeGenResult:
     """Data class containing a list of artifacts as a result of code generation."""
     files: List[GeneratedContent]
+
+    def write_if_changed(self, output_dir: str) -> List[GeneratedContent]:
+        """Write the files that differ from the existing ones in the output directory. Reply
+        the files that have been written."""
+        return [f for f in self.files if f.write_if_changed(output_dir)]
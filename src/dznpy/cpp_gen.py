@@ -234,6 +234,7 @@ class Constructor:
     initialization: str = field(default='')
     member_initlist: List[str] = field(default_factory=list)
     contents: str = field(default='')
+    inline: bool = field(default=False)  # definition with the inline specifier, e.g. in a header
 
     def __post_init__(self):
         if not isinstance(self.scope, Class) and not isinstance(self.scope, Struct):
@@ -266,7 +267,8 @@ class Constructor:
         mil = TextBlock([': ' + '\n, '.join([mv for mv in self.member_initlist])]).indent() \
             if self.member_initlist else None
         content = TextBlock(self.contents).indent() if self.contents else None
-        full_signature = f'{self.scope.name}::{self.scope.name}({params})'
+        inline = 'inline ' if self.inline else ''
+        full_signature = f'{inline}{self.scope.name}::{self.scope.name}({params})'
 
         if mil is None and not content:
             return str(TextBlock(f'{full_signature} {{}}'))
@@ -330,6 +332,7 @@ class Function:
     initialization: str = field(default='')
     contents: str = field(default='')
     scope: Struct or Class = field(default=None)
+    inline: bool = field(default=False)  # definition with the inline specifier, e.g. in a header
 
     def __post_init__(self):
         if not isinstance(self.return_type, TypeDesc):
@@ -370,7 +373,8 @@ class Function:
         name = self.name
         params = ', '.join([p.as_def for p in self.params])
         cv = f' {self.cv}' if self.cv != '' else ''
-        full_signature = f'{return_type}{scope}{name}({params}){cv}'
+        inline = 'inline ' if self.inline else ''
+        full_signature = f'{inline}{return_type}{scope}{name}({params}){cv}'
 
         if not self.contents:
             return str(TextBlock(f'{full_signature} {{}}'))
@@ -0,0 +1,122 @@
+"""
+Module providing the decoding of a binary dump of the C++ support file "Event Trace", being the
+sequence of events that crossed the boundaries of the shells, for post-mortem analysis.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+from dataclasses import dataclass, field
+import enum
+import struct
+from typing import Dict, List, Tuple
+
+# constants
+MAGIC = b'DZNTRACE'
+VERSION = 1
+RECORD_SIZE = 24
+
+
+class TracePhase(enum.Enum):
+    """Enum of the phase of an event at the boundary of a shell."""
+    ENQUEUE = 0
+    DEQUEUE = 1
+    SELECT = 2
+    DESELECT = 3
+
+
+@dataclass(frozen=True)
+class TraceName:
+    """Data class with the registered names of a trace point (port and event)."""
+    port: int
+    event: int
+    port_name: str
+    event_name: str
+
+
+@dataclass(frozen=True)
+class TraceRecord:
+    """Data class of a record of an event phase."""
+    timestamp: int  # nanoseconds of the steady clock
+    thread: int  # number of the thread, in order of its first record
+    port: int
+    event: int
+    phase: TracePhase
+
+
+@dataclass(frozen=True)
+class EventTrace:
+    """Data class of a decoded dump: the registered names and the records ordered by timestamp."""
+    names: List[TraceName]
+    records: List[TraceRecord]
+    _lookup: Dict[Tuple[int, int], str] = field(init=False, repr=False, compare=False)
+
+    def __post_init__(self):
+        object.__setattr__(self, '_lookup', {(n.port, n.event): f'{n.port_name}.{n.event_name}'
+                                             for n in self.names})
+
+    def name_of(self, record: TraceRecord) -> str:
+        """Get the name of the trace point of a record, e.g. 'MyShell.api.Start'. An unknown
+        trace point is named by its numbers."""
+        name = self._lookup.get((record.port, record.event))
+        if name is None:
+            return f'<port {record.port}>.<event {record.event}>'
+        return name
+
+    def __str__(self) -> str:
+        """Get the records as text, one line per record with the time relative to the first."""
+        start = self.records[0].timestamp if self.records else 0
+        return '\n'.join(f'{(r.timestamp - start) / 1000:>12.3f} us  thread {r.thread:<3} '
+                         f'{r.phase.name:<8} {self.name_of(r)}' for r in self.records)
+
+
+class _Reader:
+    """Helper to read little-endian values from the dump, raising a ValueError when truncated."""
+
+    def __init__(self, data: bytes):
+        self._data = data
+        self._offset = 0
+
+    def read(self, fmt: str) -> tuple:
+        size = struct.calcsize(fmt)
+        if self._offset + size > len(self._data):
+            raise ValueError(f'Event trace truncated at offset {self._offset}')
+        values = struct.unpack_from(fmt, self._data, self._offset)
+        self._offset += size
+        return values
+
+    def read_string(self) -> str:
+        length, = self.read('<H')
+        return self.read(f'<{length}s')[0].decode('utf-8', errors='replace')
+
+
+def decode(data: bytes) -> EventTrace:
+    """Decode a binary dump as written by EventTrace::Dump(). Raise a ValueError when the data is
+    not an event trace of a supported version or when it is truncated."""
+    reader = _Reader(data)
+    magic, version = reader.read('<8sI')
+    if magic != MAGIC:
+        raise ValueError('Not an event trace')
+    if version != VERSION:
+        raise ValueError(f'Unsupported event trace version {version}')
+
+    nr_names, = reader.read('<I')
+    names = []
+    for _ in range(nr_names):
+        port, event = reader.read('<HH')
+        names.append(TraceName(port, event, reader.read_string(), reader.read_string()))
+
+    nr_records, = reader.read('<I')
+    records = []
+    for _ in range(nr_records):
+        timestamp, thread, port, event, phase = reader.read('<QIHHB7x')
+        records.append(TraceRecord(timestamp, thread, port, event, TracePhase(phase)))
+
+    return EventTrace(names, records)
+
+
+def decode_file(filepath: str) -> EventTrace:
+    """Decode a binary dump file as written by EventTrace::Dump()."""
+    with open(filepath, 'rb') as file:
+        return decode(file.read())
@@ -6,6 +6,12 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
 # system modules
+from dataclasses import dataclass
+import mmap
+import re
+import sys
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
 import orjson
 
 # dznpy modules
@@ -13,7 +19,7 @@ from .ast import Binding, Bindings, Comment, Component, Data, EventDirection, En
     Event, Events, Extern, Fields, FileContents, Filename, Foreign, Formal, Formals, \
     FormalDirection, Import, Injected, Instance, Instances, Interface, Namespace, Port, \
     PortDirection, Ports, Range, Root, ScopeName, Signature, SubInt, System, Types
-from .misc_utils import NamespaceTrail
+from .misc_utils import NameSpaceIds, NamespaceTrail, scope_resolution_order
 
 
 class DznJsonError(Exception):
@@ -37,7 +43,7 @@ class ElementHelper:
         if not isinstance(self._element[key_name], str):
             raise DznJsonError(f'{self._ctx}: key "{key_name}" is not of type "str"')
 
-        return self._element[key_name]
+        return sys.intern(self._element[key_name])  # share equal names among elements
 
     def get_str_value(self, key_name: str) -> str:
         """Get the str value of the specified key_name or raise an exception on failure."""
@@ -363,7 +369,9 @@ def parse_scope_name(element: dict) -> ScopeName:
     ids = elt.get_list_value('ids')
     if len(ids) == 0:
         raise DznJsonError('parse_scope_name: list "ids" is empty')
-    return ScopeName(value=ids)
+    if not all(isinstance(x, str) for x in ids):
+        raise DznJsonError('parse_scope_name: list "ids" contains other types than "str"')
+    return ScopeName(value=[sys.intern(x) for x in ids])
 
 
 def parse_signature(element: dict) -> Signature:
@@ -402,6 +410,103 @@ def parse_types(element: dict, parent_ns: NamespaceTrail) -> Types:
     return Types(elements=elements)
 
 
+# Lazy parsing: spans (start, end) of JSON values in a memory mapped file, to parse on demand
+Span = Tuple[int, int]
+
+_JSON_TOKENS = re.compile(rb'"(?:[^"\\]|\\.)*"|[\[\]{},:]')
+_JSON_CLASS_HEADER = re.compile(rb'\{\s*"<class>"\s*:\s*"([^"\\]*)"')
+_JSON_NEXT_BRACKET = re.compile(rb'[^"\[\]{}]*(?:"(?:[^"\\]|\\.)*"[^"\[\]{}]*)*([\[\]{}])')
+_OPENERS = b'[{'
+_CLOSERS = b']}'
+_SEPARATORS = b',:'
+_WHITESPACE = b' \t\r\n'
+
+# Classes of the named (and thus referable) elements in order of search precedence that
+# corresponds to FileContents.named_containers
+NAMED_ELEMENT_CLASSES = ['component', 'enum', 'extern', 'foreign', 'interface', 'subint', 'system']
+
+
+def _strip_span(buf, start: int, end: int) -> Optional[Span]:
+    """Strip the whitespace of a span, reply None when nothing remains."""
+    while start < end and buf[start] in _WHITESPACE:
+        start += 1
+    while end > start and buf[end - 1] in _WHITESPACE:
+        end -= 1
+    return (start, end) if start < end else None
+
+
+def skip_json_container(buf, start: int) -> int:
+    """Reply the end position of the JSON object or array that starts at position start of the
+    buffer. Strings are skipped by the regex engine, only the brackets are visited."""
+    depth = 0
+    position = start
+    while True:
+        match = _JSON_NEXT_BRACKET.match(buf, position)
+        if match is None:
+            raise DznJsonError('skip_json_container: unterminated JSON container')
+        position = match.end()
+        if buf[position - 1] in _OPENERS:
+            depth += 1
+        else:
+            depth -= 1
+            if depth == 0:
+                return position
+
+
+def load_json_item(buf, start: int) -> Tuple[Any, int]:
+    """Parse the JSON object or array that starts at position start of the buffer. Reply the parsed
+    value and its end position, that is found by skipping the brackets (refer to
+    skip_json_container)."""
+    end = skip_json_container(buf, start)
+    return orjson.loads(memoryview(buf)[start:end]), end
+
+
+def split_json_container(buf, start: int,
+                         skip_child: Optional[Callable[[int, Optional[Span]], int]] = None) \
+        -> Tuple[List[Span], int]:
+    """Split the JSON object or array that starts at position start of the buffer into the spans of
+    its direct children, without parsing them. For an object the children are its keys and values
+    alternately, for an array its items. A nested child container is skipped by the callable
+    skip_child, that is given its start and the span of the preceding child (e.g. its key) and
+    replies the end position. By default it is skipped by skip_json_container(). Reply the spans
+    and the end position of the container."""
+    if skip_child is None:
+        def skip_child(position: int, _: Optional[Span]) -> int:
+            return skip_json_container(buf, position)
+
+    children = []
+    child_start = start + 1
+    position = start + 1
+    while True:
+        match = _JSON_TOKENS.search(buf, position)
+        if match is None:
+            raise DznJsonError('split_json_container: unterminated JSON container')
+
+        char = buf[match.start()]
+        if char in _OPENERS:
+            position = skip_child(match.start(), children[-1] if children else None)
+            continue
+
+        position = match.end()
+        if char in _CLOSERS or char in _SEPARATORS:
+            span = _strip_span(buf, child_start, match.start())
+            if span is not None:
+                children.append(span)
+            if char in _CLOSERS:
+                return children, position
+            child_start = position
+
+
+@dataclass(frozen=True)
+class LazyElement:
+    """Data class of a named element that has been located, but not yet parsed. It is located by the
+    span of the element itself, also when it is nested in namespaces."""
+    cls: str
+    fqn: NameSpaceIds
+    parent_ns: NamespaceTrail
+    span: Span
+
+
 class DznJsonAst:
     """Main class to process Dezyne JSON AST."""
 
@@ -409,6 +514,9 @@ class DznJsonAst:
     _verbose: bool
     _ns_trail: NamespaceTrail
     _file_contents: FileContents
+    _mmap: Optional[mmap.mmap] = None
+    _lazy_index: Optional[Dict[str, Dict[Tuple[str, ...], LazyElement]]] = None
+    _materialized: set
 
     def __init__(self, json_contents: str = None, verbose: bool = False):
         if json_contents is not None:
@@ -416,11 +524,17 @@ class DznJsonAst:
         self._verbose = verbose
         self._ns_trail = NamespaceTrail()
         self._file_contents = FileContents()
+        self._materialized = set()
 
-    def load_file(self, dezyne_filepath: str):
-        """Load Dezyne JSON contents from a file."""
+    def load_file(self, dezyne_filepath: str, lazy: bool = False):
+        """Load Dezyne JSON contents from a file. In lazy mode the file is memory mapped instead of
+        being parsed entirely. The elements are then parsed on demand by process_reachable() or
+        all at once by process()."""
         with open(dezyne_filepath, 'rb') as file:
-            self._ast = orjson.loads(file.read())
+            if lazy:
+                self._mmap = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ)
+            else:
+                self._ast = orjson.loads(file.read())
         return self  # Fluent interface
 
     def log(self, message):
@@ -438,13 +552,174 @@ class DznJsonAst:
         """Get the file contents."""
         return self._file_contents
 
+    @property
+    def is_lazy(self) -> bool:
+        """Indicate whether the contents are memory mapped and parsed on demand."""
+        return self._mmap is not None
+
     def process(self) -> FileContents:
         """"Start processing the preloaded Dezyne JSON AST and return the FileContents."""
+        if self.is_lazy:
+            for lazy_elements in self.lazy_index.values():
+                for lazy_element in lazy_elements.values():
+                    self.materialize(lazy_element)
+            return self.file_contents
+
         root = parse_root(self.ast)
         for element in root.elements:
             self.parse_element(element, self._ns_trail)
         return self.file_contents
 
+    def process_reachable(self, encapsulee_fqn: NameSpaceIds) -> FileContents:
+        """"Process only the encapsulee (system, component or foreign) and the elements reachable
+        via its ports: their interfaces and the types of the event formals and return values.
+        Of a system encapsulee also the components of its instances are processed (e.g. to shard
+        it). Only in lazy mode the other elements are skipped, otherwise everything is processed."""
+        if not self.is_lazy:
+            return self.process()
+
+        encapsulee = self.resolve(encapsulee_fqn, [])
+        if encapsulee is None:
+            return self.file_contents  # not present, the caller reports it
+
+        if isinstance(encapsulee, System):
+            for instance in encapsulee.instances.elements:
+                self.resolve(instance.type_name.value, encapsulee.parent_ns.fqn)
+
+        for port in encapsulee.ports.elements:
+            interface = self.resolve(port.type_name.value, encapsulee.parent_ns.fqn)
+            if not isinstance(interface, Interface):
+                continue
+            for event in interface.events.elements:
+                self.resolve(event.signature.type_name.value, interface.fqn)
+                for formal in event.signature.formals.elements:
+                    self.resolve(formal.type_name.value, interface.fqn)
+
+        return self.file_contents
+
+    @property
+    def lazy_index(self) -> Dict[str, Dict[Tuple[str, ...], LazyElement]]:
+        """Get the index of the located, named elements per class and fqn (lazy mode only). It is
+        built on first use by a single scan over the memory mapped file."""
+        if self._lazy_index is None:
+            self._lazy_index = {cls: {} for cls in NAMED_ELEMENT_CLASSES}
+            start = self._skip_whitespace(0)
+            if start == len(self._mmap) or self._mmap[start] != ord('{'):
+                raise DznJsonError('parse_root: element is not of type "dict"')
+
+            def skip_child(position: int, key_span: Optional[Span]) -> int:
+                if key_span is not None and self._loads(key_span) == 'elements':
+                    return self._locate_elements(position, self._ns_trail)
+                return skip_json_container(self._mmap, position)
+
+            children, _ = split_json_container(self._mmap, start, skip_child)
+            root = {self._loads(k): v for k, v in zip(children[0::2], children[1::2])}
+            if '<class>' not in root:
+                raise DznJsonError('parse_root: missing "<class>" key')
+            if self._loads(root['<class>']) != 'root':
+                raise DznJsonError('parse_root: expecting <class> having value "root"')
+            if 'elements' not in root:
+                raise DznJsonError('parse_root: missing "elements" key')
+
+        return self._lazy_index
+
+    def resolve(self, item_fqn: NameSpaceIds, as_of_scope: Optional[NameSpaceIds]):
+        """Resolve an item on its fqn with the precedence of ast_view.find_on_fqn() and materialize
+        it when it has only been located yet (lazy mode only). Reply the element or None."""
+        resolution_order = scope_resolution_order(searchable=item_fqn, calling_scope=as_of_scope)
+        lookups = [tuple(x) for x in resolution_order]
+        symbol_index = self.file_contents.symbol_index
+        lazy_index = self.lazy_index
+        for container_idx, cls in enumerate(NAMED_ELEMENT_CLASSES):
+            for lookup in lookups:
+                element = symbol_index.on_fqn[container_idx].get(lookup)
+                if element is not None:
+                    return element
+                lazy_element = lazy_index[cls].get(lookup)
+                if lazy_element is not None:
+                    self.materialize(lazy_element)
+                    return self.file_contents.symbol_index.on_fqn[container_idx].get(lookup)
+
+        return None
+
+    def materialize(self, lazy_element: LazyElement):
+        """Parse a located element (once) and add it to the file contents."""
+        if lazy_element.span not in self._materialized:
+            self._materialized.add(lazy_element.span)
+            self.parse_element(self._loads(lazy_element.span), lazy_element.parent_ns)
+
+    def _locate_elements(self, start: int, parent_ns: NamespaceTrail) -> int:
+        """Locate the named elements of the 'elements' list that starts at position start, in the
+        parent namespace. Each item is located on its own (refer to _locate_element). Non-dict
+        items are skipped with a warning. Reply the end position of the list."""
+        located = set()
+
+        def locate_item(position: int, _: Optional[Span]) -> int:
+            located.add(position)
+            return self._locate_element(position, parent_ns)
+
+        items, end = split_json_container(self._mmap, start, locate_item)
+        for span in items:
+            if span[0] not in located:
+                self.parse_element(self._loads(span), parent_ns)  # skipped with a warning
+
+        return end
+
+    def _locate_element(self, start: int, parent_ns: NamespaceTrail) -> int:
+        """Locate the element that starts at position start without parsing it entirely: it is split
+        into its keys and values, of which solely the class and name are parsed. The span of a named
+        element is kept to parse it on demand and a namespace is traversed recursively. Other
+        elements (e.g. file-name or import) are processed directly. Reply the end position."""
+        if self._mmap[start] != ord('{'):
+            element, end = load_json_item(self._mmap, start)
+            self.parse_element(element, parent_ns)  # skipped with a warning
+            return end
+
+        # a namespace that starts with its class (as Dezyne generates it) is traversed while it is
+        # split, as soon as its elements follow its name. Otherwise it is traversed afterwards.
+        skip_child = None
+        sub_ns = {}  # the namespace trail once the name has been split, 'traversed' when done
+        header = _JSON_CLASS_HEADER.match(self._mmap, start)
+        if header is not None and header.group(1) == b'namespace':
+            def skip_child(position: int, key_span: Optional[Span]) -> int:
+                key = self._loads(key_span) if key_span is not None else None
+                if key == 'elements' and 'trail' in sub_ns and self._mmap[position] == ord('['):
+                    sub_ns['traversed'] = True
+                    return self._locate_elements(position, sub_ns['trail'])
+                end_child = skip_json_container(self._mmap, position)
+                if key == 'name':
+                    scope_name = parse_scope_name(self._loads((position, end_child)))
+                    sub_ns['trail'] = NamespaceTrail(parent=parent_ns, scope_name=str(scope_name))
+                return end_child
+
+        children, end = split_json_container(self._mmap, start, skip_child)
+        values = {self._loads(k): v for k, v in zip(children[0::2], children[1::2])}
+        cls = self._loads(values['<class>']) if '<class>' in values else None
+        if 'traversed' in sub_ns:
+            pass
+        elif cls == 'namespace' and 'name' in values and 'elements' in values and \
+                self._mmap[values['elements'][0]] == ord('['):
+            scope_name = parse_scope_name(self._loads(values['name']))
+            sub_ns = NamespaceTrail(parent=parent_ns, scope_name=str(scope_name))
+            self._locate_elements(values['elements'][0], sub_ns)
+        elif cls in NAMED_ELEMENT_CLASSES and 'name' in values:
+            name = parse_scope_name(self._loads(values['name']))
+            fqn = parent_ns.fqn_member_name(name.value)
+            lazy_element = LazyElement(cls=cls, fqn=fqn, parent_ns=parent_ns, span=(start, end))
+            self._lazy_index[cls].setdefault(tuple(fqn), lazy_element)
+        else:
+            self.parse_element(self._loads((start, end)), parent_ns)  # reports a malformed one
+
+        return end
+
+    def _loads(self, span: Span):
+        return orjson.loads(self._mmap[span[0]:span[1]])
+
+    def _skip_whitespace(self, position: int) -> int:
+        while position < len(self._mmap) and self._mmap[position] in _WHITESPACE:
+            position += 1
+        return position
+
     def parse_element(self, element, parent_ns: NamespaceTrail):
         """"Parse an element and identify its type."""
         fc = self.file_contents
@@ -8,7 +8,8 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 # system modules
 import enum
 import os
-from typing import Any, List, Optional
+import sys
+from typing import Any, Dict, List, Optional, Tuple
 from typing_extensions import Self
 
 # constants
@@ -107,51 +108,66 @@ def plural(singular_noun: str, ref_collection: Any) -> str:
 
 
 class NamespaceTrail:
-    """NamespaceTrail"""
+    """NamespaceTrail, an immutable trail of scope names from the root namespace. Its fully
+    qualified name is computed once at construction into a tuple that is interned, i.e. shared by
+    all equal trails. Hence equality and hashing of trails are cheap."""
+    __slots__ = ('_parent', '_scope_name', '_fqn_ids')
 
     def __init__(self, parent: Self = None, scope_name: str = None):
         if parent is not None and scope_name is None:
             raise ValueError('scope_name required when constructing with a parent')
         if parent is None and scope_name is not None:
             raise ValueError('parent required when constructing with a scope_name')
-        self._parent = parent
-        self._scope_name = scope_name
+        fqn_ids = () if parent is None else parent.fqn_ids + (sys.intern(scope_name),)
+        object.__setattr__(self, '_parent', parent)
+        object.__setattr__(self, '_scope_name', scope_name)
+        object.__setattr__(self, '_fqn_ids', _INTERNED_FQN_IDS.setdefault(fqn_ids, fqn_ids))
+
+    def __setattr__(self, name, value):
+        raise AttributeError('NamespaceTrail is immutable')
+
+    def __delattr__(self, name):
+        raise AttributeError('NamespaceTrail is immutable')
+
+    def __reduce__(self):
+        return NamespaceTrail, (self._parent, self._scope_name)  # (re)intern when unpickling
+
+    def __eq__(self, other):
+        return isinstance(other, NamespaceTrail) and self._fqn_ids is other._fqn_ids
+
+    def __hash__(self):
+        return hash(self._fqn_ids)
 
     def __repr__(self):
         fqn = self.fqn
         return 'NamespaceTrail(<root namespace>)' if fqn is None else f'NamespaceTrail({fqn})'
 
     def __str__(self):
-        fqn = self.fqn
-        return '' if fqn is None else '.'.join(fqn)
+        return '.'.join(self._fqn_ids)
 
     @property
     def scope_name(self) -> str or None:
         """Get scope name."""
         return self._scope_name
 
+    @property
+    def fqn_ids(self) -> Tuple[str, ...]:
+        """Get the interned tuple of fully qualified namespace identifiers, that is empty for the
+        root namespace."""
+        return self._fqn_ids
+
     @property
     def fqn(self) -> NameSpaceIds or None:
         """Get the fully qualified namespace identifiers/trail."""
-        fqn_items = []
-        if self._parent is not None:
-            parent_fqn = self._parent.fqn
-            if parent_fqn is not None:
-                fqn_items.extend(parent_fqn)
-
-        if self._scope_name is not None:
-            fqn_items.append(self._scope_name)
-
-        return fqn_items if len(fqn_items) > 0 else None
+        return list(self._fqn_ids) if self._fqn_ids else None
 
     def fqn_member_name(self, member_name: NameSpaceIds) -> NameSpaceIds:
         """Create a fully qualified name for a specified member_name."""
-        result = []
-        fqn = self.fqn
-        if fqn is not None:
-            result.extend(fqn)
-        result.extend(member_name)
-        return result
+        return [*self._fqn_ids, *member_name]
+
+
+# the interned fully qualified names of all constructed NamespaceTrails
+_INTERNED_FQN_IDS: Dict[Tuple[str, ...], Tuple[str, ...]] = {}
 
 
 class Indentor(enum.Enum):
@@ -162,14 +178,19 @@ class Indentor(enum.Enum):
 
 class TextBlock:
     """"A class to store, extend, indent and stringify and collection of string lines that
-    together form a logical text block."""
-    _lines: List[str]
+    together form a logical text block. It is stored as a rope of pieces, where each piece is
+    either a line (str) or a tuple of an indentation prefix and a list of pieces. Adding an other
+    TextBlock and indenting therefore take constant time (no lines are copied or reallocated),
+    the lines are only assembled when accessed or stringified."""
+    _pieces: list
+    _is_flat: bool  # whether the pieces are lines only
 
     def __init__(self, content: Any = None):
         """Initialize with content (either an other TextBlock or other types) that will be
         flattened first to a stringized 1-dimensional list where each individual string item is
         split into substrings on presence of newlines."""
-        self._lines = []
+        self._pieces = []
+        self._is_flat = True
         if content is None:
             return
         self.add(content)
@@ -177,7 +198,12 @@ class TextBlock:
     @property
     def lines(self) -> List[str]:
         """Access the collection of text lines."""
-        return self._lines
+        if not self._is_flat:
+            lines = []
+            _assemble_lines(self._pieces, '', lines)
+            self._pieces = lines
+            self._is_flat = True
+        return self._pieces
 
     @lines.setter
     def lines(self, value: List[str]):
@@ -185,7 +211,8 @@ class TextBlock:
             raise TypeError('Argument must be a list of strings')
         if [x for x in value if not isinstance(x, str)]:
             raise TypeError('Argument must be a list of strings')
-        self._lines = value
+        self._pieces = value
+        self._is_flat = True
 
     def add(self, content: Any) -> Self:
         """Add more content with either an other TextBlock or other types of content that will be
@@ -193,16 +220,9 @@ class TextBlock:
         split into substrings on presence of newlines. As return value a self reference is returned
         (see Fluent Interface)."""
         if isinstance(content, TextBlock):
-            self.lines.extend(content.lines)
+            self._add_nested('', content)
         else:
-            split_lines_list = []
-            for x in flatten_to_strlist(content, skip_empty_strings=False):
-                if len(x) > 0:
-                    split_lines_list.extend(x.splitlines())
-                else:
-                    split_lines_list.append(x)
-
-            self.lines.extend(flatten_to_strlist(split_lines_list, skip_empty_strings=False))
+            self._add_flattened(content)
 
         return self
 
@@ -216,17 +236,62 @@ class TextBlock:
         else:
             raise TypeError(f'Invalid indentor specified: {indentor}')
 
-        def tabify(item: str) -> str:
-            return f'{tab_chars}{item}' if item else ''
-
-        self.lines = [tabify(item) for item in self.lines]
+        self._pieces = [(tab_chars, self._pieces)]
+        self._is_flat = False
         return self
 
+    def is_empty(self) -> bool:
+        """Indicate whether the text block contains no lines at all."""
+        return _pieces_are_empty(self._pieces)
+
+    def _add_flattened(self, value: Any):
+        """Add the value flattened like flatten_to_strlist() (not skipping empty strings) where
+        each string is split into lines. A TextBlock in a list is added like its stringified
+        value, so an empty TextBlock results in an empty line."""
+        if isinstance(value, str):
+            if value:
+                self._pieces.extend(value.splitlines())
+            else:
+                self._pieces.append(value)
+        elif isinstance(value, list):
+            for item in value:
+                self._add_flattened(item)
+        elif isinstance(value, dict):
+            for item in value.values():
+                self._add_flattened(item)
+        elif isinstance(value, TextBlock):
+            if value.is_empty():
+                self._pieces.append('')
+            else:
+                self._add_nested('', value)
+        elif value is not None:
+            self._add_flattened(str(value))
+
+    def _add_nested(self, prefix: str, other: Self):
+        """Add the pieces of the other TextBlock as nested piece. The list of pieces is copied
+        (shallow), so later additions to the other TextBlock are not reflected."""
+        self._pieces.append((prefix, list(other._pieces)))
+        self._is_flat = False
+
     def __str__(self):
         """"Stringify the lines to an EOL delimited and an EOL-ending string."""
         return EOL.join(self.lines) + EOL
 
 
+def _assemble_lines(pieces: list, prefix: str, lines: List[str]):
+    """Assemble the lines of the rope pieces where each non-empty line is prefixed."""
+    for piece in pieces:
+        if isinstance(piece, str):
+            lines.append(f'{prefix}{piece}' if prefix and piece else piece)
+        else:
+            _assemble_lines(piece[1], prefix + piece[0], lines)
+
+
+def _pieces_are_empty(pieces: list) -> bool:
+    """Indicate whether the rope pieces contain no lines at all."""
+    return all(not isinstance(piece, str) and _pieces_are_empty(piece[1]) for piece in pieces)
+
+
 def flatten_to_strlist(value: Any, skip_empty_strings: bool = True) -> List[str]:
     """Flatten and stringify the argument into a final 1-dimensional list of strings. Encountered
     list and dictionary items are recursively processed. Where for dictionaries only the values
@@ -0,0 +1,143 @@
+"""
+Module providing C++ code generation of the support file "Awaitable".
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, SystemIncludes, Namespace
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+
+def header_hh_template(cpp_ns: str) -> str:
+    return """\
+Awaitable
+
+Description: a C++20 coroutine awaitable that posts a job to a dispatcher (like dzn::pump) when
+             the awaiting coroutine suspends, and resumes the coroutine with the reply of the job
+             once it has been executed. As opposed to dzn::shell, no thread is blocked while the
+             job is pending.
+
+Resumer: by default (no resumer) the coroutine is resumed on the dispatcher thread. Hence it
+         must not raise a blocking (dzn::shell) in-event of a component on that same dispatcher
+         before it has moved on to an other thread, and it occupies the dispatcher until it
+         suspends again. Awaiting an other Awaitable is fine. Specify an AwaitableResumer to
+         resume the coroutine on an executor of the caller instead, e.g. by posting the handle
+         to the event loop or thread pool of the caller. The dispatcher then solely executes the
+         job.
+
+Note: an exception thrown by the job is rethrown by co_await.
+
+Example:
+
+   """ f'{cpp_ns}' """::Awaitable<int> GetValue(dzn::pump& pump, MyComponent& comp)
+   {
+       return {pump, [&comp] { return comp.api.in.GetValue(); }};
+   }
+
+   MyTask Example(dzn::pump& pump, MyComponent& comp)
+   {
+       int value = co_await GetValue(pump, comp);
+   }
+
+   """ f'{cpp_ns}' """::Awaitable<int> GetValueOnLoop(dzn::pump& pump, MyComponent& comp, MyEventLoop& loop)
+   {
+       return {pump, [&comp] { return comp.api.in.GetValue(); },
+               [&loop](std::coroutine_handle<> handle) { loop.Post([handle] { handle.resume(); }); }};
+   }
+
+"""
+
+
+def body_hh() -> str:
+    return """\
+// Resumes the awaiting coroutine on the executor of the caller, instead of on the dispatcher thread
+using AwaitableResumer = std::function<void(std::coroutine_handle<>)>;
+
+template <typename RESULT>
+class Awaitable
+{
+public:
+    template <typename DISPATCHER, typename CALLABLE>
+    Awaitable(DISPATCHER& dispatcher, CALLABLE&& callable, AwaitableResumer resumer = nullptr)
+        : m_dispatcher(&dispatcher)
+        , m_post([](void* dispatcher, std::function<void()> job) { (*static_cast<DISPATCHER*>(dispatcher))(std::move(job)); })
+        , m_callable(std::forward<CALLABLE>(callable))
+        , m_resumer(std::move(resumer))
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiter)
+    {
+        // the coroutine might be resumed (and this awaitable destroyed) before posting returns
+        auto post = m_post;
+        post(m_dispatcher, [this, awaiter] {
+            try
+            {
+                if constexpr (std::is_void_v<RESULT>) m_callable();
+                else m_result.emplace(m_callable());
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+            if (!m_resumer) return awaiter.resume();
+            auto resumer = std::move(m_resumer); // the resumer might destroy this awaitable
+            resumer(awaiter);
+        });
+    }
+
+    RESULT await_resume()
+    {
+        if (m_exception) std::rethrow_exception(m_exception);
+        if constexpr (!std::is_void_v<RESULT>) return std::move(*m_result);
+    }
+
+private:
+    struct Empty
+    {
+    };
+    using Storage = std::conditional_t<std::is_void_v<RESULT>, Empty, RESULT>;
+
+    void* m_dispatcher;
+    void (*m_post)(void*, std::function<void()>);
+    std::function<RESULT()> m_callable;
+    AwaitableResumer m_resumer;
+    std::optional<Storage> m_result;
+    std::exception_ptr m_exception;
+};
+"""
+
+
+def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that facilitates awaiting dispatched jobs."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([header_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    includes = SystemIncludes(['coroutine', 'exception', 'functional', 'optional', 'type_traits',
+                               'utility'])
+    body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
+
+    return GeneratedContent(filename=f'{file_ns}_Awaitable.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    BLANK_LINE,
+                                                    body,
+                                                    create_footer()])),
+                            namespace=ns)
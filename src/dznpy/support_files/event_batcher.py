@@ -0,0 +1,162 @@
+"""
+Module providing C++ code generation of the support file "Event Batcher".
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, SystemIncludes, Namespace
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+
+def header_hh_template(cpp_ns: str) -> str:
+    return """\
+Event Batcher
+
+Description: a front-end of a dispatcher (like dzn::pump) that enqueues a burst of events as a
+             single dispatcher job. This amortises the wake-ups of the dispatcher thread and the
+             lock acquisitions of its queue. The events of a batch are executed in order.
+
+Flush modes:
+- Burst:    the first event of a batch posts one drain job to the dispatcher. Succeeding events
+            join the batch until the dispatcher starts executing the drain job.
+- Explicit: the events are collected until Flush() is called, that posts the drain job.
+
+Ordering: every job that bypasses batching must be posted via operator() or Shell() of the
+          Event Batcher. It seals the open batch first, which is then posted (if not yet) ahead
+          of the job. Hence all events keep the order in which they were raised, as if they were
+          posted to the dispatcher one by one.
+
+Example:
+
+   """ f'{cpp_ns}' """::EventBatcher<dzn::pump> batcher(myPump, """ f'{cpp_ns}' """::BatchFlush::Burst);
+
+   batcher.Batch([&] { myComp.hal.out.Sample(1); });
+   batcher.Batch([&] { myComp.hal.out.Sample(2); });  // joins the batch of Sample(1)
+   batcher([&] { myComp.hal.out.Stopped(); });        // seals the batch, then is posted itself
+   auto result = batcher.Shell([&] { return myComp.api.in.GetState(); }); // blocking, like dzn::shell
+
+"""
+
+
+def body_hh() -> str:
+    return """\
+enum class BatchFlush
+{
+    Burst,
+    Explicit
+};
+
+template <typename DISPATCHER>
+class EventBatcher
+{
+public:
+    using Job = std::function<void()>;
+
+    EventBatcher(DISPATCHER& dispatcher, BatchFlush flush)
+        : m_dispatcher(dispatcher)
+        , m_flush(flush)
+    {
+    }
+
+    // Enqueue an event to the open batch, or open a new batch
+    void Batch(Job event)
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_open)
+        {
+            m_open = std::make_shared<Events>();
+            if (m_flush == BatchFlush::Burst) PostDrain(m_open);
+        }
+        m_open->push_back(std::move(event));
+    }
+
+    // Post the open batch (Explicit flush mode) and close it
+    void Flush()
+    {
+        std::lock_guard lock(m_mutex);
+        Seal();
+    }
+
+    // Post a job that bypasses batching, while preserving the order with the batched events
+    void operator()(const Job& job)
+    {
+        std::lock_guard lock(m_mutex);
+        Seal();
+        m_dispatcher(job);
+    }
+
+    // Post a job that bypasses batching and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto Shell(CALLABLE&& callable) -> decltype(callable())
+    {
+        using RESULT = decltype(callable());
+        std::promise<RESULT> promise;
+        (*this)([&] {
+            if constexpr (std::is_void_v<RESULT>) { callable(); promise.set_value(); }
+            else promise.set_value(callable());
+        });
+        return promise.get_future().get();
+    }
+
+private:
+    using Events = std::vector<Job>;
+
+    // Precondition: m_mutex is locked
+    void Seal()
+    {
+        if (!m_open) return;
+        if (m_flush == BatchFlush::Explicit) PostDrain(m_open);
+        m_open.reset();
+    }
+
+    // Precondition: m_mutex is locked
+    void PostDrain(const std::shared_ptr<Events>& batch)
+    {
+        m_dispatcher([this, batch] {
+            {
+                std::lock_guard lock(m_mutex);
+                if (m_open == batch) m_open.reset(); // close the batch, later events open a new one
+            }
+            for (auto& event : *batch) event();
+        });
+    }
+
+    DISPATCHER& m_dispatcher;
+    const BatchFlush m_flush;
+    std::mutex m_mutex;
+    std::shared_ptr<Events> m_open; // the batch that accepts events, nullptr when none
+};
+"""
+
+
+def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that facilitates batching of events."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([header_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    includes = SystemIncludes(['functional', 'future', 'memory', 'mutex', 'type_traits',
+                               'vector'])
+    body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
+
+    return GeneratedContent(filename=f'{file_ns}_EventBatcher.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    BLANK_LINE,
+                                                    body,
+                                                    create_footer()])),
+                            namespace=ns)
@@ -0,0 +1,148 @@
+"""
+Module providing C++ code generation of the support file "Inplace Callable".
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, SystemIncludes, Namespace
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+
+def header_hh_template(cpp_ns: str) -> str:
+    return """\
+Inplace Callable helpers
+
+Description: helpers to reroute events via std::function and dzn::pump without heap allocations.
+             A std::function stores a callable inside its own small buffer when the callable is
+             trivially copyable and small enough. Otherwise it silently allocates on the heap.
+
+Contents:
+- Inplace(): compile-time check (static_assert) that a callable fits the small buffer of
+             std::function. The maximum size is conservatively set to two pointers, being the
+             smallest small buffer of the mainstream standard library implementations.
+- InplaceShell(): blocking alternative to dzn::shell() that posts a single two-pointer callable
+                  to the dispatcher and awaits its completion on the stack of the caller. Unlike
+                  dzn::shell() there is no std::promise with heap allocated shared state. The
+                  callable argument is never copied and can therefore capture anything. An
+                  exception thrown by the callable is rethrown to the caller.
+
+Note: the storage of the queue inside dzn::pump is owned by the Dezyne runtime; it is out of scope.
+
+Example:
+
+   myPort.in.Start = """ f'{cpp_ns}' """::Inplace([this](int value) {
+       return """ f'{cpp_ns}' """::InplaceShell(m_dispatcher, [&] { return m_comp.api.in.Start(value); });
+   });
+
+   myPort.out.Done = """ f'{cpp_ns}' """::Inplace([this](int value) {
+       m_dispatcher(""" f'{cpp_ns}' """::Inplace([this, value] { m_comp.api.out.Done(value); }));
+   });
+
+"""
+
+
+def body_hh() -> str:
+    return """\
+// Maximum size of a callable that std::function is assumed to store in its small buffer
+inline constexpr std::size_t InplaceMaxSize = 2 * sizeof(void*);
+
+template <typename CALLABLE>
+inline constexpr bool IsInplaceCallable = (sizeof(CALLABLE) <= InplaceMaxSize) &&
+                                          (alignof(CALLABLE) <= alignof(void*)) &&
+                                          std::is_trivially_copyable_v<CALLABLE>;
+
+// Pass through the callable after checking it fits the small buffer of std::function
+template <typename CALLABLE>
+[[nodiscard]] auto Inplace(CALLABLE&& callable)
+{
+    static_assert(IsInplaceCallable<std::decay_t<CALLABLE>>,
+                  "Callable does not fit the small buffer of std::function (too large or "
+                  "not trivially copyable), consider capturing less or by reference");
+    return std::forward<CALLABLE>(callable);
+}
+
+// Stack allocated rendezvous between the caller thread and the dispatcher thread
+template <typename RESULT>
+class InplaceShellFrame
+{
+public:
+    template <typename CALLABLE>
+    void Execute(CALLABLE& callable)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<RESULT>) callable();
+            else m_result.emplace(callable());
+        }
+        catch (...)
+        {
+            m_exception = std::current_exception();
+        }
+
+        // notify while holding the lock: once the caller observes m_done it destroys this frame
+        std::lock_guard lock(m_mutex);
+        m_done = true;
+        m_cv.notify_one();
+    }
+
+    RESULT Await()
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_done; });
+        if (m_exception) std::rethrow_exception(m_exception);
+        if constexpr (!std::is_void_v<RESULT>) return std::move(*m_result);
+    }
+
+private:
+    using Storage = std::conditional_t<std::is_void_v<RESULT>, bool, RESULT>;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_done{false};
+    std::optional<Storage> m_result;
+    std::exception_ptr m_exception;
+};
+
+// Post the callable to the dispatcher and block the caller until it has been executed
+template <typename DISPATCHER, typename CALLABLE>
+auto InplaceShell(DISPATCHER& dispatcher, CALLABLE&& callable)
+{
+    using RESULT = std::invoke_result_t<CALLABLE&>;
+    InplaceShellFrame<RESULT> frame;
+    dispatcher(Inplace([&frame, &callable] { frame.Execute(callable); }));
+    return frame.Await();
+}
+"""
+
+
+def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that facilitates allocation free rerouting."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([header_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    includes = SystemIncludes(['condition_variable', 'cstddef', 'exception', 'mutex', 'optional',
+                               'type_traits', 'utility'])
+    body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
+
+    return GeneratedContent(filename=f'{file_ns}_InplaceCallable.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    BLANK_LINE,
+                                                    body,
+                                                    create_footer()])),
+                            namespace=ns)
@@ -26,6 +26,12 @@ Description: A simple concurrent thread safe wrapper to protect a shared resouce
              Releasing the lock can be done manually or automatically when the given lock goes
              out of scope (RAII pattern).
 
+Variants:
+- MutexWrapped<T>:       exclusive std::mutex for both read (const) and write access.
+- SharedMutexWrapped<T>: std::shared_mutex where const access takes a std::shared_lock, so
+                         concurrent readers do not serialise. Write access stays exclusive.
+- SpinWrapped<T>:        spin lock on a std::atomic_flag for very short critical sections.
+
 Tip: MutexWrap a struct containing multiple members to protect them as a whole. Considered they
      cohesively are 'atomic'. Instead of having separate locks that potentially can yield
      deadlocks when concurrent threads incrementally try to acquire them.
@@ -43,13 +49,42 @@ given """ f'{cpp_ns}' """::MutexWrapped<int> m_threadSafeNumber;
                         // let it go out of scope for automatic RAII release of the lock.
 }
 
+given """ f'{cpp_ns}' """::SharedMutexWrapped<int> m_readMostlyNumber;
+
+{
+   auto lockAndData = std::as_const(m_readMostlyNumber)(); // shared lock and read-only access
+   auto number = *lockAndData;
+}
+
 """
 
 
 def body_hh() -> str:
     return """\
-template <typename T>
-struct MutexWrapped
+// Automatic mechanism to ensure releasing the lock a la RAII
+template <typename LOCK>
+struct RaiiLockDeleter
+{
+    LOCK lock;
+
+    template <typename T>
+    void operator()(T*) { if (lock.owns_lock()) lock.unlock(); }
+};
+
+// Minimal spin lock that satisfies the Lockable requirements (usable with std::unique_lock)
+class SpinLock
+{
+public:
+    void lock() noexcept { while (m_flag.test_and_set(std::memory_order_acquire)) std::this_thread::yield(); }
+    bool try_lock() noexcept { return !m_flag.test_and_set(std::memory_order_acquire); }
+    void unlock() noexcept { m_flag.clear(std::memory_order_release); }
+
+private:
+    std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+};
+
+template <typename T, typename MUTEX, typename READ_LOCK, typename WRITE_LOCK>
+struct LockWrapped
 {
     // Get access to the protected data. May have to wait on a concurrent claiming thread to unlock
     // it first. When lock has been acquired, the client is given a unique_ptr to the data.
@@ -59,20 +94,30 @@ struct MutexWrapped
     // - implicitly and guaranteed when the unique_ptr goes out of scope (calls RaiiLockDeleter)
     auto operator()( )
     {
-        std::unique_lock lock(m_mutex);
-        return std::unique_ptr<T, RaiiLockDeleter>(&m_protectee, RaiiLockDeleter{std::move(lock)});
+        WRITE_LOCK lock(m_mutex);
+        return std::unique_ptr<T, RaiiLockDeleter<WRITE_LOCK>>(&m_protectee, RaiiLockDeleter<WRITE_LOCK>{std::move(lock)});
     }
 
-private:
-    T m_protectee;      // default construct typename T
-    std::mutex m_mutex; // the mutex coupled to the protectee
-
-    struct RaiiLockDeleter // automatic mechanism to ensure releasing the lock a la RAII
+    // Get read-only access to the protected data. Same as above but with the (possibly shared) read lock.
+    auto operator()( ) const
     {
-        std::unique_lock<std::mutex> lock;
-        void operator()(T*) { if (lock.owns_lock()) lock.unlock(); }
-    };
+        READ_LOCK lock(m_mutex);
+        return std::unique_ptr<const T, RaiiLockDeleter<READ_LOCK>>(&m_protectee, RaiiLockDeleter<READ_LOCK>{std::move(lock)});
+    }
+
+private:
+    T m_protectee;         // default construct typename T
+    mutable MUTEX m_mutex; // the mutex coupled to the protectee
 };
+
+template <typename T>
+using MutexWrapped = LockWrapped<T, std::mutex, std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>;
+
+template <typename T>
+using SharedMutexWrapped = LockWrapped<T, std::shared_mutex, std::shared_lock<std::shared_mutex>, std::unique_lock<std::shared_mutex>>;
+
+template <typename T>
+using SpinWrapped = LockWrapped<T, SpinLock, std::unique_lock<SpinLock>, std::unique_lock<SpinLock>>;
 """
 
 
@@ -86,7 +131,7 @@ def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
                            BLANK_LINE,
                            COPYRIGHT
                            ])
-    includes = SystemIncludes(['memory', 'mutex'])
+    includes = SystemIncludes(['atomic', 'memory', 'mutex', 'shared_mutex', 'thread'])
     body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
 
     return GeneratedContent(filename=f'{file_ns}_MutexWrapped.hh',
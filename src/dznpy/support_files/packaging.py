@@ -0,0 +1,137 @@
+"""
+Module providing C++ code generation of the aggregated packagings of the support files: an
+umbrella header (e.g. to precompile) and a C++20 module interface unit. Both aggregate the support
+files that are not already included by an other support file, since these lack include guards.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import re
+from typing import List, Optional
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, ProjectIncludes, SystemIncludes
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+# Support files that require a language feature beyond C++17, by the suffix of their filename and
+# the feature-test macro that the umbrella header guards their include with
+FEATURE_GUARDS = {'_Awaitable.hh': '__cpp_impl_coroutine'}
+
+
+def root_files(files: List[GeneratedContent]) -> List[GeneratedContent]:
+    """Get the support files (in order) that are not included by an other support file."""
+    included = {x for f in files for x in re.findall(r'^#include "(.+)"$', f.contents, re.M)}
+    return [f for f in files if f.filename not in included]
+
+
+def feature_guard(file: GeneratedContent) -> Optional[str]:
+    """Get the feature-test macro that is required to include the support file, if any."""
+    return next((v for k, v in FEATURE_GUARDS.items() if file.filename.endswith(k)), None)
+
+
+def system_includes(files: List[GeneratedContent]) -> List[str]:
+    """Get the sorted distinct system includes of the support files."""
+    return sorted({x for f in files for x in re.findall(r'^#include <(.+)>$', f.contents, re.M)})
+
+
+def module_name(namespace: NameSpaceIds) -> str:
+    """Get the name of the C++20 module of the support files, e.g. 'Proj.Dzn.SupportFiles'."""
+    return '.'.join(namespace + ['SupportFiles'])
+
+
+def umbrella_hh_template(cpp_ns: str) -> str:
+    return """\
+Support Files (umbrella header)
+
+Description: aggregation of all support files in a single header that is suitable to be
+             precompiled, so a translation unit does not parse the support files itself.
+
+Usage: include this header instead of the individual support files, e.g. configure it as the
+       precompiled header of the target. The support files are in namespace """ f'{cpp_ns}' """.
+       Support files that require C++20 (e.g. the coroutines of Awaitable) are only included when
+       the compiler provides the respective feature.
+
+"""
+
+
+def create_umbrella_header(files: List[GeneratedContent],
+                           namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that includes all support files."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([umbrella_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    roots = root_files(files)
+    includes = ProjectIncludes([f.filename for f in roots if feature_guard(f) is None])
+    guarded_includes = [[f'#if {feature_guard(f)}', f'#include "{f.filename}"', '#endif']
+                        for f in roots if feature_guard(f) is not None]
+
+    return GeneratedContent(filename=f'{file_ns}_SupportFiles.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    '#pragma once',
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    guarded_includes,
+                                                    BLANK_LINE,
+                                                    create_footer()])),
+                            namespace=ns)
+
+
+def module_template(name: str) -> str:
+    return """\
+Support Files (C++20 module interface unit)
+
+Description: module """ f'{name}' """ that exports all support files, so a translation unit
+             imports them instead of parsing the support files itself.
+
+Usage: compile this module interface unit as part of the target, and import the module instead of
+       including the individual support files:
+
+   import """ f'{name}' """;
+
+Note: the system includes (e.g. the Dezyne runtime headers) are in the global module fragment,
+      hence they are not exported. Include them where used.
+
+"""
+
+
+def create_module_interface(files: List[GeneratedContent],
+                            namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++20 module interface unit contents that exports all support files."""
+
+    ns, _, file_ns = initialize_ns(namespace_prefix)
+    name = module_name(ns)
+    header = CommentBlock([module_template(name),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    exports = TextBlock(['export {',
+                         [f'#include "{f.filename}"' for f in root_files(files)],
+                         '}'])
+
+    return GeneratedContent(filename=f'{file_ns}_SupportFiles.cppm',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    'module;',
+                                                    BLANK_LINE,
+                                                    SystemIncludes(system_includes(files)),
+                                                    BLANK_LINE,
+                                                    f'export module {name};',
+                                                    BLANK_LINE,
+                                                    exports,
+                                                    create_footer()])),
+                            namespace=ns)
@@ -0,0 +1,168 @@
+"""
+Module providing C++ code generation of the support file "Priority Lanes".
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, SystemIncludes, Namespace
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+
+def header_hh_template(cpp_ns: str) -> str:
+    return """\
+Priority Lanes
+
+Description: a front-end of a dispatcher (like dzn::pump) with a priority lane and a normal lane
+             of jobs. A single drain job at the dispatcher executes one job, where it always takes
+             the next job from the priority lane first, and re-posts itself while jobs remain.
+             Within a lane the jobs keep their FIFO order. Hence a flood of normal jobs delays a
+             priority job by at most the one normal job that is being executed, and the lanes do
+             not starve the other jobs of the dispatcher.
+
+Usage: every job must be posted via the Priority Lanes, because jobs posted to the dispatcher
+       directly are queued behind the pending drain job.
+
+Example:
+
+   """ f'{cpp_ns}' """::PriorityLanes<dzn::pump> lanes(myPump);
+
+   lanes([&] { myComp.hal.out.Sample(1); });          // normal lane
+   lanes.Priority([&] { myComp.hal.out.Overheat(); }); // executed before Sample(1) when still pending
+   lanes.PriorityShell([&] { myComp.api.in.Stop(); }); // blocking, like dzn::shell
+
+"""
+
+
+def body_hh() -> str:
+    return """\
+template <typename DISPATCHER>
+class PriorityLanes
+{
+public:
+    using Job = std::function<void()>;
+
+    explicit PriorityLanes(DISPATCHER& dispatcher)
+        : m_dispatcher(dispatcher)
+    {
+    }
+
+    PriorityLanes(const PriorityLanes&) = delete;
+    PriorityLanes& operator=(const PriorityLanes&) = delete;
+
+    // Post a job to the normal lane
+    void operator()(Job job) { Post(m_lanes->normal, std::move(job)); }
+
+    // Post a job to the priority lane
+    void Priority(Job job) { Post(m_lanes->priority, std::move(job)); }
+
+    // Post a job to the normal lane and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto Shell(CALLABLE&& callable) -> decltype(callable())
+    {
+        return Await(m_lanes->normal, callable);
+    }
+
+    // Post a job to the priority lane and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto PriorityShell(CALLABLE&& callable) -> decltype(callable())
+    {
+        return Await(m_lanes->priority, callable);
+    }
+
+private:
+    using Lane = std::deque<Job>;
+
+    // The lanes, shared with the pending drain job
+    struct Lanes
+    {
+        // Executed on the dispatcher thread, executes the next job. Replies true when jobs remain,
+        // the drain job must then be re-posted (drainPosted is still set).
+        bool Drain()
+        {
+            Job job;
+            {
+                std::lock_guard lock(mutex);
+                Lane& lane = priority.empty() ? normal : priority;
+                job = std::move(lane.front());
+                lane.pop_front();
+            }
+            job();
+
+            std::lock_guard lock(mutex);
+            if (!priority.empty() || !normal.empty()) return true;
+            drainPosted = false;
+            return false;
+        }
+
+        std::mutex mutex;
+        Lane priority;
+        Lane normal;
+        bool drainPosted{false};
+    };
+
+    void Post(Lane& lane, Job job)
+    {
+        std::lock_guard lock(m_lanes->mutex);
+        lane.push_back(std::move(job));
+        if (m_lanes->drainPosted) return;
+        m_lanes->drainPosted = true;
+        PostDrain(m_dispatcher, m_lanes);
+    }
+
+    // Post a drain job that co-owns the lanes, it re-posts itself while jobs remain
+    static void PostDrain(DISPATCHER& dispatcher, const std::shared_ptr<Lanes>& lanes)
+    {
+        dispatcher([&dispatcher, lanes] {
+            if (lanes->Drain()) PostDrain(dispatcher, lanes);
+        });
+    }
+
+    template <typename CALLABLE>
+    auto Await(Lane& lane, CALLABLE& callable) -> decltype(callable())
+    {
+        using RESULT = decltype(callable());
+        std::promise<RESULT> promise;
+        Post(lane, [&] {
+            if constexpr (std::is_void_v<RESULT>) { callable(); promise.set_value(); }
+            else promise.set_value(callable());
+        });
+        return promise.get_future().get();
+    }
+
+    DISPATCHER& m_dispatcher;
+    std::shared_ptr<Lanes> m_lanes{std::make_shared<Lanes>()};
+};
+"""
+
+
+def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that facilitates prioritized dispatching."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([header_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    includes = SystemIncludes(['deque', 'functional', 'future', 'memory', 'mutex',
+                               'type_traits'])
+    body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
+
+    return GeneratedContent(filename=f'{file_ns}_PriorityLanes.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    BLANK_LINE,
+                                                    body,
+                                                    create_footer()])),
+                            namespace=ns)
@@ -0,0 +1,88 @@
+"""
+Module providing C++ code generation of the support file "Reroute Helpers".
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+
+# dznpy modules
+from ..dznpy_version import COPYRIGHT
+from ..code_gen_common import GeneratedContent, BLANK_LINE, TEXT_GEN_DO_NOT_MODIFY
+from ..cpp_gen import CommentBlock, SystemIncludes, Namespace
+from ..misc_utils import TextBlock, NameSpaceIds
+
+# own modules
+from . import initialize_ns, create_footer
+
+
+def header_hh_template(cpp_ns: str) -> str:
+    return """\
+Reroute Helpers
+
+Description: helpers to reroute an event of a port via a dispatcher (like dzn::pump) to the
+             respective event of an other port, instead of an open-coded lambda per event. The
+             helpers are instantiated per dispatcher type and event signature, hence all events
+             with an equal signature share the same code.
+
+- RerouteShell: the caller is blocked until the dispatcher has handled the event (dzn::shell),
+                the arguments are passed by reference.
+- ReroutePost:  the event is posted to the dispatcher (fire-and-forget), the arguments are moved
+                into the posted job. The event must have a void return type and solely in-formals.
+
+Both helpers refer to the target event (std::function) and the dispatcher, which must outlive the
+rerouted event.
+
+Example:
+
+   myShellPort.in.Start = """ f'{cpp_ns}' """::RerouteShell(myPump, myComp.api.in.Start);
+   myShellPort.out.Sample = """ f'{cpp_ns}' """::ReroutePost(myPump, myComp.hal.out.Sample);
+
+"""
+
+
+def body_hh() -> str:
+    return """\
+template <typename DISPATCHER, typename TARGET>
+auto RerouteShell(DISPATCHER& dispatcher, TARGET& target)
+{
+    return [&dispatcher, &target](auto&&... args) {
+        return dzn::shell(dispatcher, [&] { return target(std::forward<decltype(args)>(args)...); });
+    };
+}
+
+template <typename DISPATCHER, typename TARGET>
+auto ReroutePost(DISPATCHER& dispatcher, TARGET& target)
+{
+    return [&dispatcher, &target](auto... args) {
+        dispatcher([&target, arguments = std::make_tuple(std::move(args)...)]() mutable {
+            std::apply(target, std::move(arguments));
+        });
+    };
+}
+"""
+
+
+def create_header(namespace_prefix: NameSpaceIds = None) -> GeneratedContent:
+    """Create the c++ header file contents that facilitates rerouting events via shared helper
+    templates."""
+
+    ns, cpp_ns, file_ns = initialize_ns(namespace_prefix)
+    header = CommentBlock([header_hh_template(cpp_ns),
+                           BLANK_LINE,
+                           TEXT_GEN_DO_NOT_MODIFY,
+                           BLANK_LINE,
+                           COPYRIGHT
+                           ])
+    includes = SystemIncludes(['dzn/pump.hh', 'tuple', 'utility'])
+    body = Namespace(ns, contents=TextBlock([BLANK_LINE, body_hh(), BLANK_LINE]))
+
+    return GeneratedContent(filename=f'{file_ns}_RerouteHelpers.hh',
+                            contents=str(TextBlock([header,
+                                                    BLANK_LINE,
+                                                    includes,
+                                                    BLANK_LINE,
+                                                    body,
+                                                    create_footer()])),
+                            namespace=ns)
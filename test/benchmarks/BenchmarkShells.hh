@@ -0,0 +1,26 @@
+// Benchmark Shells
+//
+// Description: access to the boundary ports of the benchmarked Advanced Shells. Each shell lives
+//              in its own translation unit (refer to ShellEnvironment.hh) and is constructed at
+//              its first access.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+#pragma once
+
+// Project includes
+#include "IToaster.hh"
+#include "IPowerCord.hh"
+
+struct ShellPorts
+{
+    ::My::Project::IToaster& api;         // client side of the boundary provides port
+    ::My::Project::Hal::IPowerCord& cord; // stub of the boundary requires port
+};
+
+ShellPorts ToasterSystemStsShellPorts();
+ShellPorts ToasterSystemMtsShellPorts();
+ShellPorts ToasterSystemZeroAllocShellPorts();
+ShellPorts ToasterOneMtsShellPorts();
+ShellPorts ToasterTwoMtsShellPorts();
@@ -0,0 +1,21 @@
+// Extern Types
+//
+// Description: definitions of the extern data types of Types.dzn for the benchmarks. This header
+//              is force-included in each translation unit (-include ExternTypes.hh).
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+#pragma once
+
+// System includes
+#include <cstddef>
+#include <string>
+
+using std::size_t;
+
+using PResultInfo = int; // global, to be resolved from shells of both namespaced and global components
+
+namespace Sub {
+using MyLongNamedType = int;
+} // namespace Sub
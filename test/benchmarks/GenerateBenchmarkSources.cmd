@@ -0,0 +1,66 @@
+@ECHO OFF
+REM Dynamic configuration by dznpy user/developer
+SET dzncmd=C:\SB\dezyne-2.17.8\dzn.cmd
+
+REM Predefined static configuration
+SET includes=-I . -I ..\shared\Facilities
+SET callerroot=%CD%
+SET scriptroot=%~dp0%
+SET modelsroot=%~dp0%..\dezyne_models\system1
+SET genfolder=%~dp0%generated
+
+REM Ensure to have an absolute filepath of dzn.cmd
+CD %scriptroot%
+CALL :absolutizeDznCmdPath %dzncmd%
+SET dzncmd_abs=%ABSPATH_RETVAL%
+
+ECHO Script configuration:
+ECHO  - dzncmd (user) = %dzncmd%
+ECHO  - dzncmd_abs    = %dzncmd_abs%
+ECHO  - callerroot    = %callerroot%
+ECHO  - scriptroot    = %scriptroot%
+ECHO  - modelsroot    = %modelsroot%
+ECHO  - genfolder     = %genfolder%
+ECHO.
+
+IF NOT EXIST %dzncmd_abs% (
+  ECHO dzn.cmd not found, please correct script variable dzncmd
+  goto :exitFailure
+)
+
+ECHO Starting processing
+
+CD %modelsroot%
+IF NOT EXIST %genfolder% MKDIR %genfolder%
+DEL /Q %genfolder%\* >nul 2> nul
+
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ ..\shared\Facilities\Types.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ ..\shared\Facilities\IConfiguration.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ ..\shared\Facilities\ITimer.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ ..\shared\Facilities\FCTimer.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ Hardware\Interfaces\IPowerCord.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ Hardware\Interfaces\IHeaterElement.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ Hardware\Interfaces\ILed.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ IToaster.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ Toaster.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ TwoToasters.dzn
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l c++ ToasterSystem.dzn
+
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l json ToasterSystem.dzn > %genfolder%\ToasterSystem.json
+CALL %dzncmd_abs% -v -p code %includes% -o %genfolder% -l json TwoToasters.dzn > %genfolder%\TwoToasters.json
+
+ECHO Generating the Advanced Shells and support files
+python %scriptroot%generate_shells.py --json-dir %genfolder% --output-dir %genfolder%
+IF ERRORLEVEL 1 goto :exitFailure
+
+ECHO Finished
+CD %callerroot%
+EXIT /B 0
+
+:absolutizeDznCmdPath
+SET ABSPATH_RETVAL=%~f1
+EXIT /B
+
+:exitFailure
+CD %callerroot%
+EXIT /B 1
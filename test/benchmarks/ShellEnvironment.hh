@@ -0,0 +1,90 @@
+// Shell Environment
+//
+// Description: an Advanced Shell with stubbed boundary ports, initialized and ready for use by the
+//              benchmarks. Include it once per translation unit after the header of the shell.
+//              The generated headers lack include guards, hence each shell has its own translation
+//              unit in the folder environments/.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+#pragma once
+
+// System includes
+#include <dzn/locator.hh>
+
+// Project includes
+#include "IConfiguration.hh"
+#include "Dzn_MetaHelpers.hh"
+#include "BenchmarkShells.hh"
+
+template <typename SHELL>
+struct ShellEnvironment
+{
+    ShellEnvironment()
+        : api(::Dzn::CreateRequiredPort<::My::Project::IToaster>("client"))
+        , heater(::Dzn::CreateProvidedPort<::Some::Vendor::IHeaterElement>("heater"))
+        , cord(::Dzn::CreateProvidedPort<::My::Project::Hal::IPowerCord>("cord"))
+        , led(::Dzn::CreateProvidedPort<::My::ILed>("led"))
+        , m_cfg(::Dzn::CreateProvidedPort<IConfiguration>("cfg"))
+        , m_shell(CreatePrototypeLocator())
+    {
+        api.out.Ok = [] {};
+        api.out.Fail = [](auto) {};
+        api.out.Error = [](auto) {};
+        heater.in.Initialize = [] {};
+        heater.in.Uninitialize = [] {};
+        heater.in.On = [] {};
+        heater.in.Off = [] {};
+        cord.in.Initialize = [] {};
+        cord.in.Uninitialize = [] {};
+        cord.in.IsConnectedToOutlet = [] { return true; };
+        led.in.Initialize = [] {};
+        led.in.Uninitialize = [] {};
+
+        Connect(m_shell.ProvidesApi(), api);
+        Connect(heater, m_shell.RequiresHeaterElement());
+        Connect(cord, m_shell.RequiresCord());
+        Connect(led, m_shell.RequiresLed());
+        m_shell.FinalConstruct();
+
+        api.in.Initialize(); // the toaster is now Idle
+    }
+
+    ~ShellEnvironment() { api.in.Uninitialize(); }
+
+    ShellPorts Ports() { return {api, cord}; }
+
+    // Client side of the boundary provides port and the stubbed boundary requires ports
+    ::My::Project::IToaster api;
+    ::Some::Vendor::IHeaterElement heater;
+    ::My::Project::Hal::IPowerCord cord;
+    ::My::ILed led;
+
+private:
+    const dzn::locator& CreatePrototypeLocator()
+    {
+        m_cfg.in.GetToastingTime = [](size_t& toastingTime) { toastingTime = 1000; };
+        return m_prototypeLocator.set(m_cfg);
+    }
+
+    // Connect a client port to a boundary provides port (STS or MTS)
+    template <template <typename> typename TS, typename P>
+    static void Connect(TS<P> provided, P& client) { ::Dzn::ConnectPorts(provided, TS<P>{client}); }
+
+    // Connect a stubbed port to a boundary requires port (STS or MTS)
+    template <template <typename> typename TS, typename P>
+    static void Connect(P& stub, TS<P> required) { ::Dzn::ConnectPorts(TS<P>{stub}, required); }
+
+    IConfiguration m_cfg;
+    dzn::locator m_prototypeLocator;
+    SHELL m_shell;
+};
+
+// Shared by all benchmark threads and constructed once (thread safe)
+template <typename SHELL>
+ShellPorts EnvironmentPorts()
+{
+    static ShellEnvironment<SHELL> environment;
+    return environment.Ports();
+}
@@ -0,0 +1,28 @@
+// Timer
+//
+// Description: implementation of the foreign component Facilities.Timer (FCTimer.dzn) for the
+//              benchmarks. The benchmarks never start toasting, hence the timer never expires.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+#pragma once
+
+// Project includes
+#include "FCTimer.hh"
+
+namespace Facilities {
+
+struct Timer : public skel::Facilities::Timer
+{
+    Timer(const dzn::locator& locator)
+        : skel::Facilities::Timer(locator)
+    {
+    }
+
+private:
+    void api_Create(size_t) override {}
+    void api_Cancel() override {}
+};
+
+} // namespace Facilities
@@ -0,0 +1,82 @@
+// Micro-benchmarks of dznpy generated Advanced Shells
+//
+// Description: measures the runtime cost of the rerouting by generated Advanced Shells:
+//              - per-event latency and throughput of in-events via STS and MTS provides ports,
+//              - throughput of out-events via STS and MTS requires ports,
+//              - two independent threaded subsystems (TwoToasters) driven concurrently.
+//              Each MTS benchmark runs with 1..N caller threads (N = hardware concurrency).
+//              STS ports are not thread safe and therefore only run with a single caller thread.
+//
+// Refer to README.md for generating the sources and building the benchmark executable.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <algorithm>
+#include <thread>
+#include <benchmark/benchmark.h>
+
+// Project includes
+#include "BenchmarkShells.hh"
+
+namespace {
+
+using PortsAccessor = ShellPorts (*)();
+
+int MaxThreads()
+{
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Latency of a blocking in-event with a reply (STS: direct call, MTS: dzn::shell round trip)
+template <PortsAccessor PORTS>
+void BM_InEventRoundTrip(benchmark::State& state)
+{
+    auto& api = PORTS().api;
+    size_t toastingTime = 0;
+    for (auto _ : state)
+    {
+        api.in.GetTime(toastingTime);
+        benchmark::DoNotOptimize(toastingTime);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Throughput of out-events raised by a requires port (MTS: posted to the dispatcher). A closing
+// in-event round trip ensures all raised out-events of the calling thread have been handled.
+template <PortsAccessor PORTS>
+void BM_OutEventThroughput(benchmark::State& state)
+{
+    auto ports = PORTS();
+    size_t toastingTime = 0;
+    for (auto _ : state)
+    {
+        ports.cord.out.Connected();
+    }
+    ports.api.in.GetTime(toastingTime);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Two threaded subsystems, each with its own dispatcher, driven by alternating caller threads
+void BM_TwoShellsRoundTrip(benchmark::State& state)
+{
+    auto& api = (state.thread_index() % 2 == 0) ? ToasterOneMtsShellPorts().api : ToasterTwoMtsShellPorts().api;
+    size_t toastingTime = 0;
+    for (auto _ : state)
+    {
+        api.in.GetTime(toastingTime);
+        benchmark::DoNotOptimize(toastingTime);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_InEventRoundTrip, ToasterSystemStsShellPorts)->Threads(1);
+BENCHMARK_TEMPLATE(BM_InEventRoundTrip, ToasterSystemMtsShellPorts)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_OutEventThroughput, ToasterSystemStsShellPorts)->Threads(1);
+BENCHMARK_TEMPLATE(BM_OutEventThroughput, ToasterSystemMtsShellPorts)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK(BM_TwoShellsRoundTrip)->ThreadRange(2, std::max(2, MaxThreads()))->UseRealTime();
+
+} // namespace
+
+BENCHMARK_MAIN();
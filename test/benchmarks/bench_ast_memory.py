@@ -0,0 +1,70 @@
+"""
+Script benchmarking the memory that a processed Dezyne JSON AST (FileContents) occupies. A Dezyne
+JSON file (default: the ToasterSystem test model) is scaled up synthetically by repeating its
+elements in distinct namespaces.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import argparse
+import gc
+import os
+import sys
+import tracemalloc
+
+import orjson
+
+# dznpy modules
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.normpath(f'{SCRIPT_DIR}/../../src'))
+
+# pylint: disable=wrong-import-position
+from dznpy.json_ast import DznJsonAst
+
+# constants
+DEFAULT_JSON_FILE = os.path.normpath(f'{SCRIPT_DIR}/../dezyne_models/generated/ToasterSystem.json')
+
+
+def scale_up(json_contents: bytes, factor: int) -> bytes:
+    """Scale up the Dezyne JSON contents by repeating its elements in the namespaces Scaled<nr>."""
+    root = orjson.loads(json_contents)
+    elements = root['elements']
+    root['elements'] = [{'<class>': 'namespace',
+                         'name': {'<class>': 'scope_name', 'ids': [f'Scaled{nr}']},
+                         'elements': elements} for nr in range(factor)]
+    return orjson.dumps(root)
+
+
+def measure(json_contents: bytes) -> (int, int):
+    """Process the Dezyne JSON contents and reply the number of named elements and the number of
+    bytes that the FileContents retains."""
+    gc.collect()
+    tracemalloc.start()
+    fc = DznJsonAst(json_contents).process()
+    gc.collect()
+    retained, _ = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return sum(len(container) for container in fc.named_containers), retained
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--json-file', default=DEFAULT_JSON_FILE,
+                        help='Dezyne JSON file to scale up (default: %(default)s)')
+    parser.add_argument('--factors', type=int, nargs='+', default=[1, 10, 100, 1000],
+                        help='scale factors to benchmark (default: %(default)s)')
+    args = parser.parse_args()
+
+    with open(args.json_file, 'rb') as file:
+        json_contents = file.read()
+
+    print(f'{"factor":>7} {"elements":>9} {"retained":>12} {"bytes/element":>14}')
+    for factor in args.factors:
+        elements, retained = measure(scale_up(json_contents, factor))
+        print(f'{factor:>7} {elements:>9} {retained:>12} {retained // elements:>14}')
+
+
+if __name__ == '__main__':
+    main()
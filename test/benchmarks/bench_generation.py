@@ -0,0 +1,91 @@
+"""
+Script benchmarking the generation time of an Advanced Shell for an encapsulee with many ports and
+events. The Dezyne AST is synthesized, hence no Dezyne (JSON) files are required.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import argparse
+import os
+import sys
+import timeit
+
+# dznpy modules
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.normpath(f'{SCRIPT_DIR}/../../src'))
+
+# pylint: disable=wrong-import-position
+from dznpy import ast
+from dznpy.adv_shell import Builder, Configuration, FacilitiesOrigin, all_mts
+from dznpy.misc_utils import NamespaceTrail
+
+# constants
+NAMESPACE = 'Bench'
+ENCAPSULEE = 'Wide'
+
+
+def create_interface(root_ns: NamespaceTrail, name: str, events_count: int) -> ast.Interface:
+    """Create an interface with in-events (half of them with a formal argument) and out-events."""
+    events = []
+    for nr in range(events_count):
+        formals = [ast.Formal('value', ast.ScopeName(['MilliSeconds']), ast.FormalDirection.IN)] \
+            if nr % 2 else []
+        direction = ast.EventDirection.IN if nr % 4 < 3 else ast.EventDirection.OUT
+        events.append(ast.Event(f'Event{nr}', ast.Signature(ast.ScopeName(['void']),
+                                                            ast.Formals(formals)), direction))
+
+    return ast.Interface(fqn=[NAMESPACE, name], parent_ns=root_ns,
+                         ns_trail=NamespaceTrail(root_ns, name), name=ast.ScopeName([name]),
+                         types=ast.Types(), events=ast.Events(events))
+
+
+def create_file_contents(ports_count: int, events_count: int) -> ast.FileContents:
+    """Create the contents of a component with an equal number of provides and requires ports,
+    each with its own interface of the specified number of events."""
+    root_ns = NamespaceTrail(NamespaceTrail(), NAMESPACE)
+    fc = ast.FileContents()
+    fc.externs.append(ast.Extern(['MilliSeconds'], NamespaceTrail(), ast.ScopeName(['MilliSeconds']),
+                                 ast.Data('size_t')))
+    ports = []
+    for nr in range(ports_count):
+        interface = create_interface(root_ns, f'IPort{nr}', events_count)
+        fc.interfaces.append(interface)
+        direction = ast.PortDirection.PROVIDES if nr % 2 == 0 else ast.PortDirection.REQUIRES
+        ports.append(ast.Port(f'port{nr}', ast.ScopeName([interface.name.value[0]]), direction,
+                              ast.Formals(), ast.Injected(False)))
+
+    fc.components.append(ast.Component([NAMESPACE, ENCAPSULEE], root_ns,
+                                       ast.ScopeName([ENCAPSULEE]), ast.Ports(ports)))
+    return fc
+
+
+def create_configuration(fc: ast.FileContents) -> Configuration:
+    """Create the configuration of a shell with all ports MTS."""
+    return Configuration(dezyne_filename='Wide.dzn', ast_fc=fc, output_basename_suffix='Shell',
+                         fqn_encapsulee_name=[NAMESPACE, ENCAPSULEE], port_cfg=all_mts(),
+                         facilities_origin=FacilitiesOrigin.CREATE, copyright='Benchmark')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--ports', type=int, nargs='+', default=[10, 100, 200, 400],
+                        help='numbers of ports to benchmark (default: %(default)s)')
+    parser.add_argument('--events', type=int, default=20,
+                        help='number of events per port (default: %(default)s)')
+    parser.add_argument('--repeat', type=int, default=5,
+                        help='number of repetitions, the fastest is reported '
+                             '(default: %(default)s)')
+    args = parser.parse_args()
+
+    print(f'{"ports":>6} {"events":>7} {"lines":>8} {"seconds":>9}')
+    for ports_count in args.ports:
+        cfg = create_configuration(create_file_contents(ports_count, args.events))
+        lines = sum(f.contents.count('\n') for f in Builder().build(cfg).files[:2])
+        seconds = min(timeit.repeat(lambda: Builder().build(cfg), number=1, repeat=args.repeat))
+        print(f'{ports_count:>6} {ports_count * args.events:>7} {lines:>8} {seconds:>9.3f}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,197 @@
+"""
+Script benchmarking how dznpy scales with the size of a Dezyne model: the parse time of the JSON AST,
+the lookup time of find_on_fqn(), the generation time of an Advanced Shell and the peak memory. The
+Dezyne JSON AST is synthesized with N namespaces, each with a number of interfaces (of a number of
+events) and a port of the encapsulated component, hence no Dezyne files are required. The results
+can be saved as baseline and later be checked against it, e.g. by a CI job.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import argparse
+import gc
+import os
+import sys
+import timeit
+import tracemalloc
+from dataclasses import dataclass, asdict
+from typing import Dict, List
+
+import orjson
+
+# dznpy modules
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.normpath(f'{SCRIPT_DIR}/../../src'))
+
+# pylint: disable=wrong-import-position
+from dznpy.adv_shell import Builder, Configuration, FacilitiesOrigin, all_mts
+from dznpy.ast_view import find_on_fqn
+from dznpy.json_ast import DznJsonAst
+
+# constants
+NAMESPACE = 'Bench'
+ENCAPSULEE = 'Scaled'
+METRICS = ['parse_s', 'lookup_us', 'generate_s', 'peak_mb']
+
+
+@dataclass(frozen=True)
+class Result:
+    """Data class with the measurements of a model scaled to N namespaces."""
+    namespaces: int
+    interfaces: int
+    events: int
+    ports: int
+    parse_s: float  # seconds to parse the JSON AST
+    lookup_us: float  # microseconds per find_on_fqn() of an interface, from the encapsulee scope
+    generate_s: float  # seconds to generate the Advanced Shell
+    peak_mb: float  # peak memory in MiB while parsing and generating
+
+
+def scope_name(*ids: str) -> dict:
+    return {'<class>': 'scope_name', 'ids': list(ids)}
+
+
+def create_event(nr: int) -> dict:
+    """Create an event, of which three quarter in-events (half of all with a formal argument)."""
+    formals = [{'<class>': 'formal', 'expression': 'undefined', 'name': 'value',
+                'type_name': scope_name('MilliSeconds'), 'direction': 'in'}] if nr % 2 else []
+    return {'<class>': 'event', 'name': f'Event{nr}', 'direction': 'in' if nr % 4 < 3 else 'out',
+            'signature': {'<class>': 'signature', 'type_name': scope_name('void'),
+                          'formals': {'<class>': 'formals', 'elements': formals}}}
+
+
+def create_interface(nr: int, events_count: int) -> dict:
+    return {'<class>': 'interface', 'name': scope_name(f'IScaled{nr}'),
+            'types': {'<class>': 'types', 'elements': []},
+            'events': {'<class>': 'events',
+                       'elements': [create_event(x) for x in range(events_count)]}}
+
+
+def create_json_ast(namespaces_count: int, interfaces_count: int, events_count: int) -> bytes:
+    """Create the Dezyne JSON AST of N namespaces Scaled<nr>, each with the specified number of
+    interfaces. The component Bench.Scaled has a port per namespace, alternating provides and
+    requires, referring to the first interface of that namespace."""
+    namespaces = [{'<class>': 'namespace', 'name': scope_name(f'Scaled{nr}'),
+                   'elements': [create_interface(x, events_count)
+                                for x in range(interfaces_count)]}
+                  for nr in range(namespaces_count)]
+    ports = [{'<class>': 'port', 'name': f'port{nr}',
+              'type_name': scope_name(f'Scaled{nr}', 'IScaled0'),
+              'direction': 'provides' if nr % 2 == 0 else 'requires',
+              'formals': {'<class>': 'formals', 'elements': []}}
+             for nr in range(namespaces_count)]
+    component = {'<class>': 'namespace', 'name': scope_name(NAMESPACE),
+                 'elements': [{'<class>': 'component', 'name': scope_name(ENCAPSULEE),
+                               'ports': {'<class>': 'ports', 'elements': ports}}]}
+    extern = {'<class>': 'extern', 'name': scope_name('MilliSeconds'),
+              'value': {'<class>': 'data', 'value': 'size_t'}}
+    return orjson.dumps({'<class>': 'root', 'elements': [extern] + namespaces + [component],
+                         'working-directory': '.'})
+
+
+def measure(namespaces_count: int, interfaces_count: int, events_count: int,
+            repeat: int) -> Result:
+    """Measure the parse, lookup and generation time (the fastest of the repetitions) and the peak
+    memory of a synthesized model."""
+    json_contents = create_json_ast(namespaces_count, interfaces_count, events_count)
+
+    def parse():
+        return DznJsonAst(json_contents).process()
+
+    fc = parse()
+    cfg = Configuration(dezyne_filename='Scaled.dzn', ast_fc=fc, output_basename_suffix='Shell',
+                        fqn_encapsulee_name=[NAMESPACE, ENCAPSULEE], port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE, copyright='Benchmark')
+    lookups = [[f'Scaled{ns}', f'IScaled{nr}'] for ns in range(namespaces_count)
+               for nr in range(interfaces_count)]
+
+    def lookup():
+        for fqn in lookups:
+            find_on_fqn(fc, fqn, [NAMESPACE])
+
+    parse_s = min(timeit.repeat(parse, number=1, repeat=repeat))
+    lookup_s = min(timeit.repeat(lookup, number=1, repeat=repeat))
+    generate_s = min(timeit.repeat(lambda: Builder().build(cfg), number=1, repeat=repeat))
+
+    del fc, cfg
+    gc.collect()
+    tracemalloc.start()
+    Builder().build(Configuration(dezyne_filename='Scaled.dzn', ast_fc=parse(),
+                                  output_basename_suffix='Shell',
+                                  fqn_encapsulee_name=[NAMESPACE, ENCAPSULEE], port_cfg=all_mts(),
+                                  facilities_origin=FacilitiesOrigin.CREATE,
+                                  copyright='Benchmark'))
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+
+    return Result(namespaces_count, namespaces_count * interfaces_count,
+                  namespaces_count * interfaces_count * events_count, namespaces_count,
+                  parse_s, lookup_s / len(lookups) * 1e6, generate_s, peak / (1024 * 1024))
+
+
+def check_baseline(results: List[Result], baseline: List[Dict], tolerance: float) -> List[str]:
+    """Check the results against the baseline results of the same number of namespaces. Reply a
+    description of each metric that exceeds its baseline value by more than the tolerance."""
+    regressions = []
+    baseline_of = {b['namespaces']: b for b in baseline}
+    for result in results:
+        reference = baseline_of.get(result.namespaces)
+        if reference is None:
+            continue
+        for metric in METRICS:
+            value, limit = getattr(result, metric), reference[metric] * (1 + tolerance)
+            if value > limit:
+                regressions.append(f'{metric} of {result.namespaces} namespaces: {value:.3f} '
+                                   f'exceeds baseline {reference[metric]:.3f} (+{tolerance:.0%})')
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--namespaces', type=int, nargs='+', default=[10, 50, 100, 200],
+                        help='numbers of namespaces (and ports) to benchmark '
+                             '(default: %(default)s)')
+    parser.add_argument('--interfaces', type=int, default=5,
+                        help='number of interfaces per namespace (default: %(default)s)')
+    parser.add_argument('--events', type=int, default=10,
+                        help='number of events per interface (default: %(default)s)')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='number of repetitions, the fastest is reported '
+                             '(default: %(default)s)')
+    parser.add_argument('--save', metavar='JSON_FILE',
+                        help='save the results as baseline to the file')
+    parser.add_argument('--baseline', metavar='JSON_FILE',
+                        help='check the results against the baseline of the file, exit with '
+                             'status 1 on a regression')
+    parser.add_argument('--tolerance', type=float, default=0.25,
+                        help='allowed fraction a result may exceed its baseline '
+                             '(default: %(default)s)')
+    args = parser.parse_args()
+
+    print(f'{"namespaces":>10} {"interfaces":>10} {"events":>7} {"ports":>6} '
+          f'{"parse s":>8} {"lookup us":>10} {"generate s":>11} {"peak MiB":>9}')
+    results = []
+    for namespaces_count in args.namespaces:
+        r = measure(namespaces_count, args.interfaces, args.events, args.repeat)
+        results.append(r)
+        print(f'{r.namespaces:>10} {r.interfaces:>10} {r.events:>7} {r.ports:>6} '
+              f'{r.parse_s:>8.3f} {r.lookup_us:>10.2f} {r.generate_s:>11.3f} {r.peak_mb:>9.1f}')
+
+    if args.save:
+        with open(args.save, 'wb') as file:
+            file.write(orjson.dumps([asdict(r) for r in results], option=orjson.OPT_INDENT_2))
+
+    if args.baseline:
+        with open(args.baseline, 'rb') as file:
+            regressions = check_baseline(results, orjson.loads(file.read()), args.tolerance)
+        for regression in regressions:
+            print(f'REGRESSION: {regression}')
+        if regressions:
+            sys.exit(1)
+        print('No regressions against the baseline')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,128 @@
+// Micro-benchmarks of dznpy generated support files
+//
+// Description: measures the runtime cost of the support files used by Advanced Shells:
+//              - lock cost of the MutexWrapped variants for write and (shared) read access,
+//              - MultiClientSelector Select/Deselect and the current client lookup per policy.
+//              Each benchmark runs with 1..N caller threads (N = hardware concurrency).
+//
+// Refer to README.md for generating the sources and building the benchmark executable.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+// Project includes
+#include "IToaster.hh"
+#include "Dzn_MultiClientSelector.hh" // includes MutexWrapped and MetaHelpers
+
+namespace {
+
+using ::My::Project::IToaster;
+
+int MaxThreads()
+{
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Lock, modify and unlock the protected data
+template <template <typename> typename LOCK_WRAPPER>
+void BM_LockWrappedWrite(benchmark::State& state)
+{
+    static LOCK_WRAPPER<std::uint64_t> number;
+    for (auto _ : state)
+    {
+        auto lockAndData = number();
+        ++*lockAndData;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Lock (possibly shared), read and unlock the protected data
+template <template <typename> typename LOCK_WRAPPER>
+void BM_LockWrappedRead(benchmark::State& state)
+{
+    static LOCK_WRAPPER<std::uint64_t> number;
+    for (auto _ : state)
+    {
+        auto lockAndData = std::as_const(number)();
+        benchmark::DoNotOptimize(*lockAndData);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_LockWrappedWrite, ::Dzn::MutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockWrappedWrite, ::Dzn::SharedMutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockWrappedWrite, ::Dzn::SpinWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockWrappedRead, ::Dzn::MutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockWrappedRead, ::Dzn::SharedMutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LockWrappedRead, ::Dzn::SpinWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+
+// A MultiClientSelector with a registered client per benchmark thread and muted logging
+template <template <typename> typename LOCK_WRAPPER>
+struct SelectorEnvironment
+{
+    SelectorEnvironment()
+        : m_log()
+        , selector(m_log, "api", [](const ::Dzn::ClientIdentifier& identifier) { return ::Dzn::CreateRequiredPort<IToaster>(identifier); })
+    {
+        for (int i = 0; i < MaxThreads(); ++i) handles.push_back(selector.Index("client" + std::to_string(i)).handle);
+        selector.FinalConstruct();
+    }
+
+    const ::Dzn::ILog m_log; // default: muted sinks, of which the messages are not even built
+    ::Dzn::MultiClientSelector<IToaster, LOCK_WRAPPER> selector;
+    std::vector<::Dzn::ClientHandle> handles;
+};
+
+template <template <typename> typename LOCK_WRAPPER>
+SelectorEnvironment<LOCK_WRAPPER>& Selector()
+{
+    static SelectorEnvironment<LOCK_WRAPPER> environment;
+    return environment;
+}
+
+// Claim and release the selector by multiple clients concurrently (contention on the selection)
+template <template <typename> typename LOCK_WRAPPER>
+void BM_SelectorSelectDeselect(benchmark::State& state)
+{
+    auto& environment = Selector<LOCK_WRAPPER>();
+    const auto handle = environment.handles[state.thread_index()];
+    for (auto _ : state)
+    {
+        environment.selector.Select(handle);
+        environment.selector.Deselect(handle);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Look up the current client, as done for each arbitrated out-event
+template <template <typename> typename LOCK_WRAPPER>
+void BM_SelectorCurrentClient(benchmark::State& state)
+{
+    auto& environment = Selector<LOCK_WRAPPER>();
+    if (state.thread_index() == 0) environment.selector.Select(environment.handles.front());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(environment.selector.CurrentClientPort());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_SelectorSelectDeselect, ::Dzn::MutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorSelectDeselect, ::Dzn::SharedMutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorSelectDeselect, ::Dzn::SpinWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorSelectDeselect, ::Dzn::AtomicSelect)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorCurrentClient, ::Dzn::MutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorCurrentClient, ::Dzn::SharedMutexWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorCurrentClient, ::Dzn::SpinWrapped)->ThreadRange(1, MaxThreads())->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SelectorCurrentClient, ::Dzn::AtomicSelect)->ThreadRange(1, MaxThreads())->UseRealTime();
+
+} // namespace
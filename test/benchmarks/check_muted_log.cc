@@ -0,0 +1,126 @@
+// Zero cost check of muted logging with the support file ILog
+//
+// Description: counts the heap allocations (by replacing the global operator new) of logging via
+//              a default constructed ILog, of which the sinks are muted, through the logger chain
+//              of a MultiClientSelector (ILogWithContext of an ILogWithContext). Since the muted
+//              sinks are recognized, Select() and Deselect() do not even build their messages.
+//              It also checks that an ILogWithContext copies its (temporary) parent log and follows
+//              the level of it.
+//              The check fails (exit status 1) when muted logging allocates or a check fails.
+//
+// Refer to README.md for generating the sources and building the check executable.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+// Dezyne includes
+#include <dzn/meta.hh>
+
+// Project includes
+#include "Dzn_MultiClientSelector.hh"
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+} // namespace
+
+// Counting replacements of the global allocation functions
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Minimal port as required by the MultiClientSelector
+struct Port
+{
+    struct
+    {
+        dzn::port::meta provide;
+        dzn::port::meta require;
+    } meta;
+
+    void check_bindings() const {}
+};
+
+// Select and deselect a client via a selector with a default (muted) log, reply the number of
+// heap allocations in the steady state
+std::size_t CountMutedAllocations(int nrSelections)
+{
+    ::Dzn::MultiClientSelector<Port> selector(::Dzn::ILog{}, "api", [](const std::string&) { return Port{}; });
+    const auto handle = selector.Index("client").handle;
+    selector.FinalConstruct();
+
+    const auto before = g_allocations.load();
+    for (int i = 0; i < nrSelections; ++i)
+    {
+        selector.Select(handle);
+        selector.Deselect(handle);
+    }
+    return g_allocations.load() - before;
+}
+
+// Log via contexts of a temporary parent log and of a parent log of which the level changes
+bool CheckContextLevels()
+{
+    std::string logged;
+    ::Dzn::ILog log = {
+        [&](auto msg) { logged += "I:" + msg + ";"; },
+        [&](auto msg) { logged += "W:" + msg + ";"; },
+        [&](auto msg) { logged += "E:" + msg + ";"; }
+    };
+    ::Dzn::ILogWithContext context("ctx", log);
+    ::Dzn::ILogWithContext subContext("sub", context);
+    ::Dzn::ILogWithContext copyContext("copy", ::Dzn::ILog{log}); // the copy shares the level of log
+
+    subContext.Info("a");
+    log.SetLevel(::Dzn::LogLevel::Warning);
+    subContext.Info("b");
+    copyContext.LazyInfo([] { return "c"; });
+    subContext.Warning("d");
+    log.SetLevel(::Dzn::LogLevel::Info);
+    context.SetLevel(::Dzn::LogLevel::Error);
+    subContext.Warning("e");
+    copyContext.Info("f");
+
+    return logged == "I:ctx/sub/a;W:ctx/sub/d;I:copy/f;";
+}
+
+} // namespace
+
+int main()
+{
+    constexpr int nrSelections = 10000;
+    const auto allocations = CountMutedAllocations(nrSelections);
+    std::printf("%-28s %12s\n", "logging", "allocations");
+    std::printf("%-28s %12zu\n", "muted (default ILog)", allocations);
+
+    if (allocations != 0)
+    {
+        std::printf("FAILED: %zu heap allocations for %d x 2 muted selections\n", allocations, nrSelections);
+        return EXIT_FAILURE;
+    }
+    if (!CheckContextLevels())
+    {
+        std::printf("FAILED: the levels of the contexts are not followed\n");
+        return EXIT_FAILURE;
+    }
+    std::printf("PASSED: no heap allocations for %d x 2 muted selections\n", nrSelections);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,129 @@
+// Zero heap allocation check of the rerouting generated with Configuration.zero_alloc_rerouting
+//
+// Description: counts the heap allocations (by replacing the global operator new) of the steady
+//              state event path of the generated shell ToasterSystemZeroAllocShell (refer to
+//              generate_shells.py): blocking in-events (InplaceShell), posted in-events and posted
+//              out-events. The queue storage of dzn::pump and the handling by the encapsulee are
+//              owned by the Dezyne runtime and out of scope. Hence the allocations are checked
+//              against the sum of two references:
+//              - the same events via ToasterSystemStsShell, that calls the encapsulee directly,
+//              - the same number of allocation free jobs posted straight to a dzn::pump.
+//              As control, the default rerouting (ToasterSystemMtsShell) is counted too.
+//              The check fails (exit status 1) when the zero allocation rerouting allocates more.
+//
+// Refer to README.md for generating the sources and building the check executable.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <dzn/pump.hh>
+
+// Project includes
+#include "BenchmarkShells.hh"
+#include "Dzn_InplaceCallable.hh"
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+} // namespace
+
+// Counting replacements of the global allocation functions
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using PortsAccessor = ShellPorts (*)();
+
+// Reply the number of heap allocations of a number of rounds in the steady state
+template <typename ROUNDS>
+std::size_t CountAllocations(ROUNDS&& rounds, int nrRounds)
+{
+    rounds(100); // warm up
+    const auto before = g_allocations.load();
+    rounds(nrRounds);
+    return g_allocations.load() - before;
+}
+
+// Each round raises a blocking in-event, a posted in-event (api.SetTime) and two posted out-events
+std::size_t CountShellAllocations(PortsAccessor accessor, int nrRounds)
+{
+    auto ports = accessor();
+    size_t toastingTime = 0;
+    return CountAllocations(
+        [&](int count) {
+            for (int i = 0; i < count; ++i)
+            {
+                ports.api.in.GetTime(toastingTime);
+                ports.api.in.SetTime(toastingTime);
+                ports.cord.out.Connected();
+                ports.cord.out.Disconnected(i);
+            }
+            ports.api.in.GetTime(toastingTime); // the posted events have been handled once it returns
+        },
+        nrRounds);
+}
+
+// Each round posts the same number of jobs to a dzn::pump as a round of CountShellAllocations
+std::size_t CountPumpAllocations(int nrRounds)
+{
+    dzn::pump pump;
+    return CountAllocations(
+        [&](int count) {
+            for (int i = 0; i < count; ++i)
+            {
+                ::Dzn::InplaceShell(pump, [] {});
+                pump(::Dzn::Inplace([] {}));
+                pump(::Dzn::Inplace([] {}));
+                pump(::Dzn::Inplace([] {}));
+            }
+            ::Dzn::InplaceShell(pump, [] {});
+        },
+        nrRounds);
+}
+
+} // namespace
+
+int main()
+{
+    constexpr int nrRounds = 10000;
+    const auto zeroAlloc = CountShellAllocations(ToasterSystemZeroAllocShellPorts, nrRounds);
+    const auto encapsulee = CountShellAllocations(ToasterSystemStsShellPorts, nrRounds);
+    const auto pump = CountPumpAllocations(nrRounds);
+    const auto control = CountShellAllocations(ToasterSystemMtsShellPorts, nrRounds);
+    const auto reference = encapsulee + pump;
+
+    std::printf("%-36s %12s\n", "rerouting", "allocations");
+    std::printf("%-36s %12zu\n", "zero_alloc_rerouting", zeroAlloc);
+    std::printf("%-36s %12zu\n", "reference: encapsulee (STS shell)", encapsulee);
+    std::printf("%-36s %12zu\n", "reference: dzn::pump queue", pump);
+    std::printf("%-36s %12zu\n", "default (control)", control);
+
+    if (control <= reference)
+    {
+        std::printf("FAILED: the allocations are not counted\n");
+        return EXIT_FAILURE;
+    }
+    if (zeroAlloc > reference)
+    {
+        std::printf("FAILED: %zu heap allocations by the rerouting of %d x 4 events\n", zeroAlloc - reference,
+                    nrRounds);
+        return EXIT_FAILURE;
+    }
+    std::printf("PASSED: no heap allocations by the rerouting of %d x 4 events\n", nrRounds);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,13 @@
+// Environment of the benchmarked Advanced Shell ToasterOneMtsShell
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// Project includes
+#include "ToasterOneMtsShell.hh"
+#include "ShellEnvironment.hh"
+
+ShellPorts ToasterOneMtsShellPorts()
+{
+    return EnvironmentPorts<::ToasterOneMtsShell>();
+}
@@ -0,0 +1,13 @@
+// Environment of the Advanced Shell ToasterSystemZeroAllocShell (refer to check_zero_alloc.cc)
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// Project includes
+#include "ToasterSystemZeroAllocShell.hh"
+#include "ShellEnvironment.hh"
+
+ShellPorts ToasterSystemZeroAllocShellPorts()
+{
+    return EnvironmentPorts<::My::Project::ToasterSystemZeroAllocShell>();
+}
@@ -0,0 +1,111 @@
+"""
+Script generating the Advanced Shells and support files that are measured by the C++ micro-benchmarks.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import argparse
+from dataclasses import dataclass, field
+import os
+import sys
+from typing import Any, Dict, List
+
+# dznpy modules
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.normpath(f'{SCRIPT_DIR}/../../src'))
+
+# pylint: disable=wrong-import-position
+from dznpy import ast
+from dznpy.adv_shell import Builder, Configuration, EventSelect, FacilitiesOrigin, PortCfg, \
+    PortSelect, PortWildcard, all_mts, all_sts_mixed_ts
+from dznpy.code_gen_common import CodeGenResult, GeneratedContent
+from dznpy.json_ast import DznJsonAst
+from dznpy.misc_utils import namespaceids_t
+
+# constants
+DEFAULT_OUTPUT_DIR = os.path.normpath(f'{SCRIPT_DIR}/generated')
+COPYRIGHT = 'Benchmark of dznpy generated code. This is free software, released under the MIT License.'
+
+
+@dataclass(frozen=True)
+class ShellVariant:
+    """Data class specifying an Advanced Shell to generate for the benchmarks."""
+    json_file: str
+    dezyne_file: str
+    encapsulee: str
+    suffix: str
+    port_cfg: PortCfg
+    options: Dict[str, Any] = field(default_factory=dict)  # further Configuration fields
+
+
+def all_sts() -> PortCfg:
+    """Configure all provides and requires ports with single-threaded runtime semantics (STS)."""
+    return all_sts_mixed_ts(sts_requires_ports=PortSelect(PortWildcard.ALL),
+                            mts_requires_ports=PortSelect(PortWildcard.NONE))
+
+
+SHELL_VARIANTS = [
+    ShellVariant('ToasterSystem.json', 'ToasterSystem.dzn', 'My.Project.ToasterSystem', 'StsShell',
+                 all_sts()),
+    ShellVariant('ToasterSystem.json', 'ToasterSystem.dzn', 'My.Project.ToasterSystem', 'MtsShell',
+                 all_mts()),
+    ShellVariant('ToasterSystem.json', 'ToasterSystem.dzn', 'My.Project.ToasterSystem',
+                 'ZeroAllocShell', all_mts(),
+                 {'zero_alloc_rerouting': True, 'async_in_events': EventSelect({'api.SetTime'}),
+                  'inplace_externs': {'My.Project.MyType'}}),
+    ShellVariant('TwoToasters.json', 'TwoToasters.dzn', 'ToasterOne', 'MtsShell', all_mts()),
+    ShellVariant('TwoToasters.json', 'TwoToasters.dzn', 'My.Project.ToasterTwo', 'MtsShell',
+                 all_mts()),
+]
+
+
+def load_file_contents(json_dir: str, json_files: List[str]) -> Dict[str, ast.FileContents]:
+    """Load and process each Dezyne JSON file once."""
+    result = {}
+    for json_file in json_files:
+        filepath = os.path.join(json_dir, json_file)
+        if not os.path.isfile(filepath):
+            raise FileNotFoundError(f'"{filepath}" not found. Generate it first with '
+                                    f'GenerateBenchmarkSources.cmd')
+        result[json_file] = DznJsonAst().load_file(filepath).process()
+    return result
+
+
+def generate(json_dir: str, output_dir: str) -> List[GeneratedContent]:
+    """Generate all shell variants and the support files (once) into the output directory. Only
+    changed files are written (and replied), to not trigger needless rebuilds."""
+    fcs = load_file_contents(json_dir, sorted({v.json_file for v in SHELL_VARIANTS}))
+    files = {}
+    builder = Builder()
+    for json_file, fc in fcs.items():
+        cfgs = [Configuration(dezyne_filename=variant.dezyne_file,
+                              ast_fc=fc,
+                              output_basename_suffix=variant.suffix,
+                              fqn_encapsulee_name=namespaceids_t(variant.encapsulee),
+                              port_cfg=variant.port_cfg,
+                              facilities_origin=FacilitiesOrigin.CREATE,
+                              copyright=COPYRIGHT,
+                              **variant.options)
+                for variant in SHELL_VARIANTS if variant.json_file == json_file]
+        for file in builder.build_batch(cfgs).files:
+            files[file.filename] = file  # support files are identical for all batches
+
+    return CodeGenResult(list(files.values())).write_if_changed(output_dir)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--json-dir', default=DEFAULT_OUTPUT_DIR,
+                        help='folder containing the Dezyne JSON files (default: %(default)s)')
+    parser.add_argument('--output-dir', default=DEFAULT_OUTPUT_DIR,
+                        help='folder to write the generated files to (default: %(default)s)')
+    args = parser.parse_args()
+
+    for file in generate(args.json_dir, args.output_dir):
+        print(f'Generated {file.filename}')
+
+
+if __name__ == '__main__':
+    main()
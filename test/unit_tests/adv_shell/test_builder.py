@@ -13,11 +13,13 @@ from typing import List
 from dznpy import ast
 from dznpy.adv_shell import PortSelect, PortWildcard, all_sts_all_mts, all_mts_all_sts, \
     all_mts_mixed_ts, all_sts_mixed_ts, all_mts, Configuration, Builder, \
-    FacilitiesOrigin, GeneratedContent as GC
+    FacilitiesOrigin, GeneratedContent as GC, EventSelect, BatchFlush, DispatcherOverflow, \
+    SupportFilesPackaging
 from dznpy.adv_shell.types import AdvShellError
 from dznpy.code_gen_common import GeneratedContent
 from dznpy.support_files import strict_port, ilog, misc_utils, meta_helpers, \
-    multi_client_selector, mutex_wrapped
+    multi_client_selector, mutex_wrapped, inplace_callable, event_batcher, event_statistics, \
+    bounded_dispatcher, priority_lanes, awaitable, reroute_helpers, event_trace, packaging
 from dznpy.misc_utils import namespaceids_t
 from dznpy.json_ast import DznJsonAst
 
@@ -43,17 +45,34 @@ def get_fc(dezyne_filename) -> ast.FileContents:
     return dzn_json.process()
 
 
+def get_fc_twin_timers() -> ast.FileContents:
+    """Helper to extend the FileContents of the ToasterSystem with the system ToasterTimers, that
+    is the ToasterSystem plus an independent timer instance that is bound to an extra provides
+    port. Hence it can be split in two shards: (sut, t1) and (t2)."""
+    fc = get_fc(DZN_FILE1)
+    toaster_system = fc.systems[0]
+    timer_port = ast.Port('timer', ast.ScopeName(['ITimer']), ast.PortDirection.PROVIDES,
+                          ast.Formals(), ast.Injected(False))
+    bindings = toaster_system.bindings.elements + [
+        ast.Binding(ast.EndPoint('timer'), ast.EndPoint('api', 't2'))]
+    instances = toaster_system.instances.elements + [
+        ast.Instance('t2', ast.ScopeName(['Facilities', 'Timer']))]
+    fc.systems.append(ast.System(['My', 'Project', 'ToasterTimers'], toaster_system.parent_ns,
+                                 ast.ScopeName(['ToasterTimers']),
+                                 ast.Ports(toaster_system.ports.elements + [timer_port]),
+                                 ast.Instances(instances), ast.Bindings(bindings)))
+    return fc
+
+
 # unit tests
 
-def assert_all_default_support_files(files: List[GeneratedContent]):
-    """Assert all known support files with default namespace Dzn to be present in the
-    provided CodeGenResult argument."""
-    assert ilog.create_header() in files
-    assert meta_helpers.create_header() in files
-    assert misc_utils.create_header() in files
-    assert multi_client_selector.create_header() in files
-    assert mutex_wrapped.create_header() in files
-    assert strict_port.create_header() in files
+def assert_default_support_files(files: List[GeneratedContent], *features):
+    """Assert the base support files followed by the support files of the specified feature
+    modules, all with default namespace Dzn, to be the only support files in the provided
+    CodeGenResult argument."""
+    expected = [m.create_header() for m in [strict_port, ilog, misc_utils, meta_helpers,
+                                            multi_client_selector, mutex_wrapped, *features]]
+    assert [f for f in files if f.filename.startswith('Dzn_')] == expected
 
 
 def test_system_component_not_found():
@@ -83,7 +102,7 @@ def test_generate_all_sts_all_mts():
     result = Builder().build(cfg)
     assert GC('ToasterSystemAdvShell.hh', HH_ALL_STS_ALL_MTS) in result.files
     assert GC('ToasterSystemAdvShell.cc', CC_ALL_STS_ALL_MTS) in result.files
-    assert_all_default_support_files(result.files)
+    assert_default_support_files(result.files)
 
 
 def test_generate_all_mts_all_sts():
@@ -105,6 +124,7 @@ def test_generate_all_mts_all_sts():
     assert multi_client_selector.create_header(['Other', 'Project']) in result.files
     assert mutex_wrapped.create_header(['Other', 'Project']) in result.files
     assert strict_port.create_header(['Other', 'Project']) in result.files
+    assert len(result.files) == 2 + 6  # solely the support files that are required
 
 
 def test_generate_all_mts_mixed_ts():
@@ -121,7 +141,7 @@ def test_generate_all_mts_mixed_ts():
     result = Builder().build(cfg)
     assert GC('ToasterSystemAdvShell.hh', HH_ALL_MTS_MIXED_TS) in result.files
     assert GC('ToasterSystemAdvShell.cc', CC_ALL_MTS_MIXED_TS) in result.files
-    assert_all_default_support_files(result.files)
+    assert_default_support_files(result.files)
 
 
 def test_generate_all_sts_mixed_ts():
@@ -138,7 +158,7 @@ def test_generate_all_sts_mixed_ts():
     result = Builder().build(cfg)
     assert GC('StoneAgeToasterImplComp.hh', HH_ALL_STS_MIXED_TS) in result.files
     assert GC('StoneAgeToasterImplComp.cc', CC_ALL_STS_MIXED_TS) in result.files
-    assert_all_default_support_files(result.files)
+    assert_default_support_files(result.files)
 
 
 def test_generate_all_mts():
@@ -153,4 +173,857 @@ def test_generate_all_mts():
     result = Builder().build(cfg)
     assert GC('ToasterSystemAdvShell.hh', HH_ALL_MTS) in result.files
     assert GC('ToasterSystemAdvShell.cc', CC_ALL_MTS) in result.files
-    assert_all_default_support_files(result.files)
+    assert_default_support_files(result.files)
+
+
+def test_generate_async_in_events_all():
+    """Test a system component where all eligible in-events are fire-and-forget."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, verbose=True,
+                        async_in_events=EventSelect(PortWildcard.ALL))
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert hh.filename == 'ToasterSystemAdvShell.hh'
+    assert CONFIG_LINE_ASYNC_ALL in hh.contents
+    assert cc.filename == 'ToasterSystemAdvShell.cc'
+    assert CC_ASYNC_ALL_IN_EVENTS in cc.contents
+
+
+def test_generate_async_in_events_selected():
+    """Test a system component where a single in-event is explicitly fire-and-forget."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, verbose=True,
+                        async_in_events=EventSelect({'api.SetTime'}))
+
+    result = Builder().build(cfg)
+    assert CC_ASYNC_SELECTED_IN_EVENTS in result.files[1].contents
+
+
+def test_generate_async_in_events_fail():
+    """Test the misconfigurations of asynchronous in-events."""
+    scenarios = [
+        (all_mts(), {'unknown'}, "Configured async in-event ports ['unknown'] not matched"),
+        (all_sts_all_mts(), {'api'},
+         'Async in-events require port "api" to be configured with MTS'),
+        (all_mts(), {'api.Bogus'}, 'Configured async in-event "api.Bogus" not found'),
+        (all_mts(), {'api.Toast'},
+         'Configured async in-event "api.Toast" must have a void return type and only '
+         'in-formals'),
+        (all_mts(), {'api.GetTime'},
+         'Configured async in-event "api.GetTime" must have a void return type and only '
+         'in-formals'),
+    ]
+
+    for port_cfg, selection, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=port_cfg,
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, async_in_events=EventSelect(selection))
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_zero_alloc_rerouting():
+    """Test a system component where the rerouting of events is free of heap allocations."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, verbose=True,
+                        async_in_events=EventSelect({'api.Cancel'}),
+                        zero_alloc_rerouting=True, inplace_externs={'My.Project.MyType'})
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert CONFIG_LINE_ZERO_ALLOC in hh.contents
+    assert "// - Inplace externs: ['My.Project.MyType']\n" in hh.contents
+    assert HH_INCLUDES_ZERO_ALLOC in hh.contents
+    assert CC_ZERO_ALLOC_IN_EVENTS in cc.contents
+    assert CC_ZERO_ALLOC_OUT_EVENTS in cc.contents
+    assert 'dzn::shell' not in cc.contents
+    assert_default_support_files(result.files, inplace_callable)
+
+    # an argument of a known scalar type is captured by value as well
+    cfg.async_in_events = EventSelect({'api.Cancel', 'api.SetTime'})
+    cc = Builder().build(cfg).files[1]
+    assert 'm_dispatcher(::Dzn::Inplace([this, toastingTime] { return m_encapsulee.api.in.' \
+           'SetTime(toastingTime); }));' in cc.contents
+
+
+def test_generate_zero_alloc_rerouting_fail():
+    """Test the events that can not be rerouted free of heap allocations, because the posted job
+    would not fit the small buffer of std::function, and the invalid inplace externs."""
+    scenarios = [
+        (set(), {}, 'Event cord.Disconnected can not be rerouted free of heap allocations: '
+                    'argument exampleParameter of extern type My.Project.MyType is not '
+                    'configured as inplace extern'),
+        ({'My.Project.Bogus'}, {}, 'Configured inplace extern "My.Project.Bogus" not found'),
+        ({'My.Project.MyType'}, {'zero_alloc_rerouting': False},
+         'Inplace externs require zero heap allocation rerouting'),
+    ]
+
+    for selection, options, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, inplace_externs=selection,
+                            **{'zero_alloc_rerouting': True, **options})
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_without_zero_alloc_rerouting():
+    """Test the Inplace Callable support file is not included when not configured."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT)
+
+    result = Builder().build(cfg)
+    assert 'Dzn_InplaceCallable.hh' not in result.files[0].contents
+    assert 'Inplace' not in result.files[1].contents
+
+
+def test_generate_batched_out_events():
+    """Test a system component where the out-events of a requires port are batched."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, verbose=True,
+                        batched_out_events=EventSelect({'cord'}),
+                        batch_flush=BatchFlush.EXPLICIT)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert CONFIG_LINE_BATCHED in hh.contents
+    assert '#include "Dzn_EventBatcher.hh"' in hh.contents
+    assert '    void FlushOutEvents();\n' in hh.contents
+    assert HH_BATCHER_MEMBER in hh.contents
+    assert CC_BATCHER_MIL in cc.contents
+    assert CC_BATCHED_IN_EVENTS in cc.contents
+    assert CC_BATCHED_OUT_EVENTS in cc.contents
+    assert CC_FLUSH_OUT_EVENTS in cc.contents
+    assert 'dzn::shell' not in cc.contents
+    assert_default_support_files(result.files, event_batcher)
+
+
+def test_generate_batched_out_events_fail():
+    """Test the misconfigurations of batched out-events."""
+    scenarios = [
+        (all_mts(), {'api'}, {}, "Configured batched out-event ports ['api'] not matched"),
+        (all_mts_all_sts(), {'cord'}, {},
+         'Batched out-events require port "cord" to be configured with MTS'),
+        (all_mts(), {'cord.Bogus'}, {}, 'Configured batched out-event "cord.Bogus" not found'),
+        (all_mts(), {'cord'}, {'zero_alloc_rerouting': True},
+         'Batched out-events can not be combined with zero heap allocation rerouting'),
+    ]
+
+    for port_cfg, selection, options, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=port_cfg,
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, batched_out_events=EventSelect(selection),
+                            **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_instrumentation():
+    """Test a system component where the rerouted events are instrumented."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, verbose=True,
+                        instrumentation=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Instrumentation: event latencies and queue depth\n' in hh.contents
+    assert '#include "Dzn_EventStatistics.hh"' in hh.contents
+    assert '    const ::Dzn::EventStatistics& Statistics() const;\n' in hh.contents
+    assert HH_STATISTICS_MEMBER in hh.contents
+    assert CC_INSTRUMENTED_IN_EVENTS in cc.contents
+    assert CC_INSTRUMENTED_OUT_EVENTS in cc.contents
+    assert CC_STATISTICS_ACCESSOR in cc.contents
+    assert_default_support_files(result.files, event_statistics)
+
+
+def test_generate_without_instrumentation():
+    """Test that nothing of the instrumentation is generated when it is not configured."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT)
+
+    result = Builder().build(cfg)
+    assert 'Statistics' not in result.files[0].contents
+    assert 'statistics' not in result.files[1].contents
+
+
+def test_generate_instrumentation_fail():
+    """Test that instrumentation can not be combined with zero heap allocation rerouting."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, instrumentation=True, zero_alloc_rerouting=True)
+
+    with pytest.raises(AdvShellError) as exc:
+        Builder().build(cfg)
+    assert str(exc.value) == 'Instrumentation can not be combined with zero heap allocation ' \
+                             'rerouting'
+
+
+def test_generate_compile_time_wiring():
+    """Test a system component where the port wiring is checked at compile-time and the functors
+    are moved to the encapsulee in FinalConstruct."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, compile_time_wiring=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Port wiring: compile-time checked, functors moved\n' in hh.contents
+    assert '#include <dzn/runtime.hh>\n#include <type_traits>\n#include <utility>\n' in cc.contents
+    assert CC_COMPILE_TIME_WIRING_FINAL_CONSTRUCT in cc.contents
+    assert 'm_encapsulee.check_bindings();' not in cc.contents
+    assert_default_support_files(result.files)
+
+
+def test_generate_without_compile_time_wiring():
+    """Test that the functors are copied and all encapsulee bindings are checked at runtime when
+    compile-time wiring is not configured."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT)
+
+    cc = Builder().build(cfg).files[1]
+    assert 'static_assert' not in cc.contents
+    assert '= std::move(m_' not in cc.contents
+    assert '#include <type_traits>' not in cc.contents
+    assert '    m_encapsulee.api.out = m_ppApi.out;\n' in cc.contents
+    assert '    m_encapsulee.check_bindings();\n' in cc.contents
+
+
+def test_generate_same_thread_bypass():
+    """Test a system component where synchronous in-events raised on the dispatcher thread are
+    handled directly and counted as bypassed by the instrumentation."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, instrumentation=True, same_thread_bypass=True,
+                        async_in_events=EventSelect({'api.Cancel'}))
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Same-thread bypass: in-events raised on the dispatcher thread are handled ' \
+           'directly\n' in hh.contents
+    assert '#include <atomic>\n#include <thread>\n' in hh.contents
+    assert HH_DISPATCHER_THREAD_MEMBER in hh.contents
+    assert '    , m_dispatcherThread(std::thread::id())\n' in cc.contents
+    assert CC_BYPASSED_IN_EVENT in cc.contents
+    assert CC_RECORD_DISPATCHER_THREAD in cc.contents
+    assert cc.contents.count('m_statistics.Bypassed(*counters)') == 6  # all but async api.Cancel
+    assert_default_support_files(result.files, event_statistics)
+
+
+def test_generate_same_thread_bypass_fail():
+    """Test that the same-thread bypass can not be combined with batched out-events."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, same_thread_bypass=True,
+                        batched_out_events=EventSelect(PortWildcard.ALL))
+
+    with pytest.raises(AdvShellError) as exc:
+        Builder().build(cfg)
+    assert str(exc.value) == 'Same-thread bypass can not be combined with batched out-events'
+
+
+def test_generate_bounded_dispatcher():
+    """Test a system component where all events are admitted to the dispatcher via the Bounded
+    Dispatcher, synchronous in-events via its blocking Shell()."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, instrumentation=True,
+                        async_in_events=EventSelect({'api.Cancel'}),
+                        dispatcher_capacity=1000,
+                        dispatcher_overflow=DispatcherOverflow.DROP_OLDEST)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Bounded dispatcher: capacity 1000 (overflow: DropOldest)\n' in hh.contents
+    assert '#include "Dzn_BoundedDispatcher.hh"' in hh.contents
+    assert '    const ::Dzn::BoundedDispatcher<dzn::pump>& DispatcherQueue() const;\n' in hh.contents
+    assert HH_BOUNDED_DISPATCHER_MEMBER in hh.contents
+    assert '    , m_boundedDispatcher(m_dispatcher, 1000, ::Dzn::DispatcherOverflow::DropOldest)\n' \
+           in cc.contents
+    assert CC_BOUNDED_IN_EVENTS in cc.contents
+    assert CC_BOUNDED_OUT_EVENT in cc.contents
+    assert CC_DISPATCHER_QUEUE_ACCESSOR in cc.contents
+    assert 'dzn::shell(' not in cc.contents
+    assert_default_support_files(result.files, event_statistics, bounded_dispatcher)
+
+
+def test_generate_bounded_dispatcher_fail():
+    """Test the invalid configurations of the Bounded Dispatcher."""
+    scenarios = [
+        (-1, False, PortWildcard.NONE, 'Dispatcher capacity -1 must be a non-negative integer'),
+        (True, False, PortWildcard.NONE, 'Dispatcher capacity True must be a non-negative integer'),
+        (100, True, PortWildcard.NONE, 'Bounded dispatcher can not be combined with zero heap '
+                                       'allocation rerouting'),
+        (100, False, PortWildcard.ALL, 'Bounded dispatcher can not be combined with batched '
+                                       'out-events'),
+    ]
+
+    for capacity, zero_alloc, batched, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, dispatcher_capacity=capacity,
+                            zero_alloc_rerouting=zero_alloc,
+                            batched_out_events=EventSelect(batched))
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_priority_events():
+    """Test a system component where the selected events are dispatched via the priority lane and
+    the other events via the normal lane of the Priority Lanes."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, priority_events=EventSelect({'api.Cancel', 'led'}),
+                        async_in_events=EventSelect({'api.Cancel'}), same_thread_bypass=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert "// - Priority events: ['api.Cancel', 'led']\n" in hh.contents
+    assert '#include "Dzn_PriorityLanes.hh"' in hh.contents
+    assert HH_PRIORITY_LANES_MEMBER in hh.contents
+    assert '    , m_priorityLanes(m_dispatcher)\n' in cc.contents
+    assert CC_PRIORITY_IN_EVENTS in cc.contents
+    assert CC_PRIORITY_OUT_EVENTS in cc.contents
+    assert 'dzn::shell(' not in cc.contents
+    assert_default_support_files(result.files, priority_lanes)
+
+
+def test_generate_priority_events_fail():
+    """Test the invalid configurations of priority events."""
+    combination = 'Priority events can not be combined with zero heap allocation rerouting, ' \
+                  'a bounded dispatcher or batched out-events'
+    scenarios = [
+        (all_mts(), {'bogus'}, {}, "Configured priority event ports ['bogus'] not matched"),
+        (all_sts_all_mts(), {'api'}, {},
+         'Priority events require port "api" to be configured with MTS'),
+        (all_mts(), {'api.Ok'}, {}, 'Configured priority event "api.Ok" not found'),
+        (all_mts(), {'led.Initialize'}, {}, 'Configured priority event "led.Initialize" not found'),
+        (all_mts(), {'api'}, {'zero_alloc_rerouting': True}, combination),
+        (all_mts(), {'api'}, {'dispatcher_capacity': 10}, combination),
+        (all_mts(), {'api'}, {'batched_out_events': EventSelect(PortWildcard.ALL)}, combination),
+    ]
+
+    for port_cfg, selection, options, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=port_cfg,
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, priority_events=EventSelect(selection),
+                            **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_awaitable_in_events():
+    """Test a system component with an awaitable variant of the in-events of its provides ports
+    (MTS), that post to the dispatcher and resume the awaiting C++20 coroutine with the reply."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, awaitable_in_events=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Awaitable in-events: C++20 coroutines\n' in hh.contents
+    assert '#include "Dzn_Awaitable.hh"' in hh.contents
+    assert HH_AWAITABLE_API in hh.contents
+    assert CC_AWAITABLE_API in cc.contents
+    assert_default_support_files(result.files, awaitable)
+
+
+def test_generate_awaitable_in_events_fail():
+    """Test the invalid combinations of awaitable in-events with other rerouting options."""
+    for options in [{'zero_alloc_rerouting': True}, {'dispatcher_capacity': 10},
+                    {'priority_events': EventSelect({'api'})}]:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, awaitable_in_events=True, **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == 'Awaitable in-events can not be combined with zero heap ' \
+                                 'allocation rerouting, a bounded dispatcher or priority events'
+
+
+def test_generate_shared_buffer_externs():
+    """Test a system component where the arguments of the configured extern type are moved into a
+    shared buffer when the event is posted to the dispatcher, while other arguments are moved."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, shared_buffer_externs={'My.Project.MyType'})
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert "// - Shared buffer externs: ['My.Project.MyType']\n" in hh.contents
+    assert '#include <memory>\n' in cc.contents
+    assert CC_SHARED_BUFFER_OUT_EVENT in cc.contents
+    assert_default_support_files(result.files)
+
+
+def test_generate_shared_buffer_externs_fail():
+    """Test the invalid configurations of shared buffer externs."""
+    scenarios = [
+        ({'My.Project.Bogus'}, {}, 'Configured shared buffer extern "My.Project.Bogus" not found'),
+        ({'My.Project.IToaster'}, {},
+         'Configured shared buffer extern "My.Project.IToaster" not found'),
+        ({'MilliSeconds'}, {'zero_alloc_rerouting': True},
+         'Shared buffer externs can not be combined with zero heap allocation rerouting'),
+    ]
+
+    for selection, options, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, shared_buffer_externs=selection, **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_reroute_helpers():
+    """Test a system component where the plain rerouted events are a shared template helper,
+    while events that need a specific rerouting (like priority) keep their open-coded lambda."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, reroute_helpers=True,
+                        async_in_events=EventSelect({'api'}))
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Event rerouting: shared template helpers\n' in hh.contents
+    assert '#include "Dzn_RerouteHelpers.hh"' in hh.contents
+    assert CC_REROUTE_HELPERS_IN_EVENTS in cc.contents
+    assert CC_REROUTE_HELPERS_OUT_EVENTS in cc.contents
+    assert_default_support_files(result.files, reroute_helpers)
+
+    # the blocking in-events via the priority lanes, a priority event and an argument passed as
+    # shared buffer are not plain
+    cfg.priority_events = EventSelect({'led'})
+    cfg.shared_buffer_externs = {'My.Project.MyType'}
+    cc = Builder().build(cfg).files[1]
+    assert 'm_ppApi.in.Initialize = ::Dzn::ReroutePost(m_priorityLanes, ' in cc.contents
+    assert 'm_ppApi.in.GetTime = [&](size_t& toastingTime) {' in cc.contents
+    assert 'm_rpCord.out.Connected = ::Dzn::ReroutePost(m_priorityLanes, ' in cc.contents
+    assert 'm_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {' in cc.contents
+    assert 'm_rpLed.out.GlitchOccurred = [&] {' in cc.contents
+
+
+def test_generate_reroute_helpers_fail():
+    """Test the invalid combinations with the reroute helpers."""
+    for options in [{'zero_alloc_rerouting': True}, {'instrumentation': True}]:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, reroute_helpers=True, **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == 'Reroute helpers can not be combined with zero heap allocation ' \
+                                 'rerouting or instrumentation'
+
+
+def test_generate_header_only():
+    """Test a system component of which solely the headerfile is generated, with the definitions
+    of the sourcefile inline after the struct declaration."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, header_only=True, compile_time_wiring=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    assert hh.filename == 'ToasterSystemAdvShell.hh'
+    assert 'ToasterSystemAdvShell.cc' not in [f.filename for f in result.files]
+    assert '// - Header-only: definitions inline, no sourcefile\n' in hh.contents
+    assert HH_HEADER_ONLY_INCLUDES in hh.contents
+    assert HH_HEADER_ONLY_DEFINITIONS in hh.contents
+    assert 'inline void ToasterSystemAdvShell::FinalConstruct(' in hh.contents
+    assert hh.contents.count('\ninline ') == 8
+    assert_default_support_files(result.files)
+
+    # the definitions equal those of the sourcefile besides the inline specifier
+    cfg.header_only = False
+    cc = Builder().build(cfg).files[1]
+    definitions = cc.contents.split('namespace My::Project {\n')[1].split('} // namespace')[0]
+    assert definitions.count('\ninline ') == 0
+    assert definitions in hh.contents.replace('\ninline ', '\n')
+
+
+def test_generate_support_files_packaging():
+    """Test a system component that includes the umbrella header of the support files, or that
+    imports the C++20 module of the support files, instead of the individual support files."""
+    scenarios = [
+        (SupportFilesPackaging.UMBRELLA_HEADER, 'Umbrella header',
+         '#include "ToasterSystem.hh"\n#include "Proj_Dzn_SupportFiles.hh"\n\nnamespace',
+         'Proj_Dzn_SupportFiles.hh'),
+        (SupportFilesPackaging.MODULE, 'C++20 module',
+         '#include "ToasterSystem.hh"\n\nimport Proj.Dzn.SupportFiles;\n\nnamespace',
+         'Proj_Dzn_SupportFiles.cppm'),
+    ]
+
+    for selection, overview, includes, filename in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, support_files_ns_prefix=namespaceids_t('Proj'),
+                            support_files_packaging=selection, awaitable_in_events=True)
+
+        result = Builder().build(cfg)
+        hh = result.files[0]
+        assert f'// - Support files: {overview}\n' in hh.contents
+        assert includes in hh.contents
+        assert 'Dzn_StrictPort.hh' not in hh.contents
+        assert 'Dzn_Awaitable.hh' not in hh.contents
+        assert len(result.files) == 2 + 14 + 1
+        assert result.files[-1].filename == filename
+        assert strict_port.create_header(['Proj']) in result.files
+
+    # the aggregations are present solely when configured
+    cfg.support_files_packaging = SupportFilesPackaging.HEADERS
+    result = Builder().build(cfg)
+    assert len(result.files) == 2 + 6 + 1  # solely the base support files and Awaitable
+    assert packaging.create_umbrella_header(result.files[2:], ['Proj']).filename not in \
+           [f.filename for f in result.files]
+
+
+def test_generate_event_trace():
+    """Test a system component where each rerouted event records its enqueue and dequeue phase in
+    the Event Trace, also combined with instrumentation and the same-thread bypass."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, event_trace=True,
+                        async_in_events=EventSelect({'api.Cancel'}))
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Event trace: per-thread ring buffers\n' in hh.contents
+    assert '#include "Dzn_EventTrace.hh"' in hh.contents
+    assert CC_EVENT_TRACE_IN_EVENTS in cc.contents
+    assert CC_EVENT_TRACE_OUT_EVENTS in cc.contents
+    assert_default_support_files(result.files, event_trace)
+
+    cfg.async_in_events = EventSelect(PortWildcard.NONE)
+    cfg.instrumentation = True
+    cfg.same_thread_bypass = True
+    cc = Builder().build(cfg).files[1]
+    assert CC_EVENT_TRACE_INSTRUMENTED_BYPASS in cc.contents
+
+    # without the event trace its support file is not included
+    cfg.event_trace = False
+    hh = Builder().build(cfg).files[0]
+    assert 'Dzn_EventTrace.hh' not in hh.contents
+    assert 'Event trace' not in hh.contents
+
+
+def test_generate_event_trace_fail():
+    """Test the invalid combinations with the event trace."""
+    for options in [{'zero_alloc_rerouting': True}, {'reroute_helpers': True}]:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                            port_cfg=all_mts(),
+                            facilities_origin=FacilitiesOrigin.CREATE,
+                            copyright=COPYRIGHT, event_trace=True, **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == 'Event trace can not be combined with zero heap allocation ' \
+                                 'rerouting or reroute helpers'
+
+
+def test_generate_sharded():
+    """Test a system component of which the independent instances are split in two shards, each
+    with its own dispatcher and runtime via which the events of its boundary ports are rerouted."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc_twin_timers(),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterTimers'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT, sharded=True,
+                        async_in_events=EventSelect({'timer.Cancel'}), awaitable_in_events=True)
+
+    result = Builder().build(cfg)
+    hh = result.files[0]
+    cc = result.files[1]
+    assert '// - Sharded dispatchers: 2 threaded subsystems (sut, t1), (t2)\n' in hh.contents
+    assert '    dzn::locator& Locator1();\n    dzn::locator& Locator2();\n' in hh.contents
+    assert HH_SHARDED_MEMBERS in hh.contents
+    assert 'm_encapsulee' not in hh.contents + cc.contents
+    assert CC_SHARDED_CONSTRUCTOR in cc.contents
+    assert CC_SHARDED_IN_EVENTS in cc.contents
+    assert '        return dzn::shell(m_dispatcher1, [&] { return m_sut.api.in.Cancel(); });\n' \
+           in cc.contents
+    assert CC_SHARDED_FINAL_CONSTRUCT in cc.contents
+    assert '    return {m_shell->m_dispatcher2, [shell = m_shell] { ' \
+           'return shell->m_t2.api.in.Cancel(); }, m_resumer};\n' in cc.contents
+    assert_default_support_files(result.files, awaitable)
+
+
+def test_generate_sharded_lazily_loaded():
+    """Test sharding a system of which solely the reachable elements of a lazily loaded (and
+    namespaced) Dezyne file are processed, including the components of its instances."""
+    fqn = namespaceids_t('My.Project.ToasterSystem')
+    lazy_fc = DznJsonAst().load_file(DZN_FILE1, lazy=True).process_reachable(fqn)
+    results = [Builder().build(Configuration(dezyne_filename=DZN_FILE1, ast_fc=fc,
+                                             output_basename_suffix='AdvShell',
+                                             fqn_encapsulee_name=fqn, port_cfg=all_mts(),
+                                             facilities_origin=FacilitiesOrigin.CREATE,
+                                             copyright=COPYRIGHT, sharded=True))
+               for fc in [lazy_fc, get_fc(DZN_FILE1)]]
+    assert '// - Sharded dispatchers: 1 threaded subsystems (sut, t1)\n' in \
+           results[0].files[0].contents
+    assert results[0].files == results[1].files
+
+
+def test_generate_sharded_fail():
+    """Test the invalid configurations of a sharded shell."""
+    combination = 'Sharding can not be combined with instrumentation, compile-time wiring, ' \
+                  'same-thread bypass, a bounded dispatcher, batched out-events or priority events'
+    scenarios = [
+        ('My.Project.Toaster', FacilitiesOrigin.CREATE, {},
+         'Only a system component can be sharded'),
+        ('My.Project.ToasterTimers', FacilitiesOrigin.IMPORT, {},
+         'Sharding requires the facilities to be created, one dispatcher and runtime per shard'),
+        ('My.Project.ToasterTimers', FacilitiesOrigin.CREATE, {'instrumentation': True},
+         combination),
+        ('My.Project.ToasterTimers', FacilitiesOrigin.CREATE, {'dispatcher_capacity': 10},
+         combination),
+        ('My.Project.ToasterTimers', FacilitiesOrigin.CREATE,
+         {'priority_events': EventSelect({'api'})}, combination),
+    ]
+
+    for encapsulee, facilities_origin, options, message in scenarios:
+        cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc_twin_timers(),
+                            output_basename_suffix='AdvShell',
+                            fqn_encapsulee_name=namespaceids_t(encapsulee),
+                            port_cfg=all_mts(),
+                            facilities_origin=facilities_origin,
+                            copyright=COPYRIGHT, sharded=True, **options)
+
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build(cfg)
+        assert str(exc.value) == message
+
+
+def test_generate_batch():
+    """Test a batch of shells sharing one FileContents. Expect each shell equal to building it
+    separately and the support files once per namespace prefix."""
+    fc = get_fc(DZN_FILE1)
+    cfgs = [Configuration(dezyne_filename=DZN_FILE1, ast_fc=fc,
+                          output_basename_suffix=suffix,
+                          fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                          port_cfg=port_cfg,
+                          facilities_origin=FacilitiesOrigin.CREATE,
+                          copyright=COPYRIGHT, support_files_ns_prefix=ns_prefix)
+            for suffix, port_cfg, ns_prefix in [('StsShell', all_sts_all_mts(), None),
+                                                ('MtsShell', all_mts(), None),
+                                                ('OtherShell', all_mts(),
+                                                 namespaceids_t('Other.Project'))]]
+
+    result = Builder().build_batch(cfgs)
+    assert len(result.files) == 3 * 2 + 2 * 6
+    for cfg in cfgs:
+        for file in Builder().build(cfg).files:
+            assert file in result.files
+    assert_default_support_files(result.files)
+    assert GC_OTHERPROJECT_DZN_STRICT_PORT_HH in result.files
+    assert [f.filename for f in result.files][:6] == [
+        'ToasterSystemStsShell.hh', 'ToasterSystemStsShell.cc',
+        'ToasterSystemMtsShell.hh', 'ToasterSystemMtsShell.cc',
+        'ToasterSystemOtherShell.hh', 'ToasterSystemOtherShell.cc']
+
+
+def test_generate_batch_required_support_files():
+    """Test a batch of shells that require different support files. Expect the support files to
+    be the union of the required ones, in order of first use."""
+    fc = get_fc(DZN_FILE1)
+    cfgs = [Configuration(dezyne_filename=DZN_FILE1, ast_fc=fc,
+                          output_basename_suffix=suffix,
+                          fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                          port_cfg=all_mts(),
+                          facilities_origin=FacilitiesOrigin.CREATE,
+                          copyright=COPYRIGHT, **options)
+            for suffix, options in [('PlainShell', {}),
+                                    ('TracedShell', {'event_trace': True}),
+                                    ('CountedShell', {'instrumentation': True,
+                                                      'event_trace': True})]]
+
+    result = Builder().build_batch(cfgs)
+    assert len(result.files) == 3 * 2 + 6 + 2
+    assert_default_support_files(result.files, event_trace, event_statistics)
+
+def test_generate_batch_fail():
+    """Test the batch scenarios that are refused."""
+    cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                        output_basename_suffix='AdvShell',
+                        fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                        port_cfg=all_mts(),
+                        facilities_origin=FacilitiesOrigin.CREATE,
+                        copyright=COPYRIGHT)
+    other_fc_cfg = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                                 output_basename_suffix='OtherShell',
+                                 fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                                 port_cfg=all_mts(),
+                                 facilities_origin=FacilitiesOrigin.CREATE,
+                                 copyright=COPYRIGHT)
+
+    for cfgs, message in [([], 'Batch without configurations'),
+                          ([cfg, other_fc_cfg], 'Batch configurations do not share the same AST '
+                                                'FileContents'),
+                          ([cfg, cfg], "Batch configurations generate duplicate files: "
+                                       "['ToasterSystemAdvShell.cc', 'ToasterSystemAdvShell.hh']")]:
+        with pytest.raises(AdvShellError) as exc:
+            Builder().build_batch(cfgs)
+        assert str(exc.value) == message
+
+
+def test_generate_parallel():
+    """Test building shells by multiple worker processes. Expect a result identical to that of a
+    batch build, also when the configurations are spread unevenly over the workers."""
+    fc = get_fc(DZN_FILE1)
+    cfgs = [Configuration(dezyne_filename=DZN_FILE1, ast_fc=fc,
+                          output_basename_suffix=f'Shell{nr}',
+                          fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                          port_cfg=all_mts() if nr % 2 else all_sts_all_mts(),
+                          facilities_origin=FacilitiesOrigin.CREATE,
+                          copyright=COPYRIGHT,
+                          support_files_ns_prefix=namespaceids_t('Other.Project') if nr == 3
+                          else None)
+            for nr in range(5)]
+
+    expected = Builder().build_batch(cfgs)
+    for max_workers in [1, 2, 3]:
+        result = Builder().build_parallel(cfgs, max_workers=max_workers)
+        assert [(f.filename, f.contents_hash) for f in result.files] == \
+               [(f.filename, f.contents_hash) for f in expected.files]
+
+
+def test_builder_reentrant():
+    """Test the builder is stateless: building with one instance in between does not affect the
+    files of another build."""
+    cfg1 = Configuration(dezyne_filename=DZN_FILE1, ast_fc=get_fc(DZN_FILE1),
+                         output_basename_suffix='AdvShell',
+                         fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                         port_cfg=all_sts_all_mts(),
+                         facilities_origin=FacilitiesOrigin.IMPORT,
+                         copyright=COPYRIGHT)
+    cfg2 = Configuration(dezyne_filename=DZN_FILE2, ast_fc=get_fc(DZN_FILE2),
+                         output_basename_suffix='AdvShell',
+                         fqn_encapsulee_name=namespaceids_t('StoneAgeToaster'),
+                         port_cfg=all_mts(),
+                         facilities_origin=FacilitiesOrigin.CREATE,
+                         copyright=COPYRIGHT)
+
+    sut = Builder()
+    first = sut.build(cfg1)
+    sut.build(cfg2)
+    assert sut.build(cfg1) == first
+    assert GC('ToasterSystemAdvShell.hh', HH_ALL_STS_ALL_MTS) in first.files
@@ -0,0 +1,117 @@
+"""
+Testsuite validating the incremental (re)generation aspects of the adv_shell module.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import dataclasses
+import pytest
+
+# dznpy modules
+from dznpy import ast
+from dznpy.ast_view import find_on_fqn
+from dznpy.json_ast import DznJsonAst
+from dznpy.misc_utils import namespaceids_t
+
+# system-under-test
+from dznpy.adv_shell import Builder, Configuration, FacilitiesOrigin, PortSelect, all_mts, \
+    all_sts_mixed_ts
+from dznpy.adv_shell.incremental import create_depfile, input_fingerprint
+from dznpy.adv_shell.types import AdvShellError
+
+# test helpers
+from common.helpers import resolve
+from common.testdata import COPYRIGHT
+from testdata_builder import TOASTER_SYSTEM_JSON_FILE
+
+# test constants
+DZN_FILE1 = resolve(__file__, TOASTER_SYSTEM_JSON_FILE, '../')
+
+
+# local test helpers
+
+def get_fc() -> ast.FileContents:
+    """Helper to load the JSON AST tree of a Dezyne file and proces it into FileContents data."""
+    return DznJsonAst().load_file(DZN_FILE1).process()
+
+
+def create_cfg(fc: ast.FileContents, **kwargs) -> Configuration:
+    """Helper to create a configuration of a shell around the ToasterSystem."""
+    return Configuration(**{**dict(dezyne_filename='models/ToasterSystem.dzn', ast_fc=fc,
+                                   output_basename_suffix='AdvShell',
+                                   fqn_encapsulee_name=namespaceids_t('My.Project.ToasterSystem'),
+                                   port_cfg=all_mts(),
+                                   facilities_origin=FacilitiesOrigin.CREATE,
+                                   copyright=COPYRIGHT), **kwargs})
+
+
+def with_extra_event(fc: ast.FileContents, interface_fqn: str) -> ast.FileContents:
+    """Helper to copy the file contents where the specified interface has an extra in-event."""
+    itf = find_on_fqn(fc, namespaceids_t(interface_fqn), [])
+    event = ast.Event('Extra', ast.Signature(ast.ScopeName(['void']), ast.Formals()),
+                      ast.EventDirection.IN)
+    changed = dataclasses.replace(itf, events=ast.Events(itf.events.elements + [event]))
+    return dataclasses.replace(fc, interfaces=[changed if x is itf else x for x in fc.interfaces])
+
+
+# unit tests
+
+def test_input_fingerprint():
+    """Test the fingerprint is deterministic and only changes on changes of the configuration or
+    of the dependencies of the encapsulee."""
+    fc = get_fc()
+    sut = input_fingerprint(create_cfg(fc))
+    assert len(sut) == 32
+    assert sut == input_fingerprint(create_cfg(get_fc()))
+    assert sut != input_fingerprint(create_cfg(fc, copyright='Other'))
+    assert sut != input_fingerprint(create_cfg(fc, port_cfg=all_sts_mixed_ts(
+        sts_requires_ports=PortSelect({'cord', 'led'}),
+        mts_requires_ports=PortSelect({'heaterElement'}))))
+    assert sut == input_fingerprint(create_cfg(with_extra_event(fc, 'ITimer')))
+    assert sut != input_fingerprint(create_cfg(with_extra_event(fc, 'My.ILed')))
+
+
+def test_input_fingerprint_fail():
+    with pytest.raises(AdvShellError) as exc:
+        input_fingerprint(create_cfg(get_fc(), fqn_encapsulee_name=['Unknown']))
+    assert str(exc.value) == "Encapsulee ['Unknown'] not found"
+
+
+def test_build_incremental():
+    """Test only the shells with changed inputs are rebuilt."""
+    fc = get_fc()
+    cfgs = [create_cfg(fc), create_cfg(fc, output_basename_suffix='OtherShell')]
+
+    first = Builder().build_incremental(cfgs, {})
+    assert first.rebuilt == ['ToasterSystemAdvShell', 'ToasterSystemOtherShell']
+    assert first.result == Builder().build_batch(cfgs)
+    assert sorted(first.fingerprints) == first.rebuilt
+
+    unchanged = Builder().build_incremental(cfgs, first.fingerprints)
+    assert unchanged.rebuilt == []
+    assert unchanged.result.files == []
+    assert unchanged.fingerprints == first.fingerprints
+
+    cfgs[1] = create_cfg(fc, output_basename_suffix='OtherShell', instrumentation=True)
+    changed = Builder().build_incremental(cfgs, first.fingerprints)
+    assert changed.rebuilt == ['ToasterSystemOtherShell']
+    assert [f.filename for f in changed.result.files][:2] == ['ToasterSystemOtherShell.hh',
+                                                              'ToasterSystemOtherShell.cc']
+    assert changed.fingerprints['ToasterSystemAdvShell'] == \
+           first.fingerprints['ToasterSystemAdvShell']
+
+
+def test_create_depfile():
+    fc = get_fc()
+    sut = create_depfile(create_cfg(fc), output_dir='out dir',
+                         extra_inputs=['json/ToasterSystem.json'])
+    assert sut.filename == 'ToasterSystemAdvShell.d'
+    assert sut.contents == 'out\\ dir/ToasterSystemAdvShell.hh out\\ dir/ToasterSystemAdvShell.cc: ' \
+                           'models/ToasterSystem.dzn models/IToaster.dzn json/ToasterSystem.json\n'
+
+
+def test_create_depfile_header_only():
+    sut = create_depfile(create_cfg(get_fc(), header_only=True))
+    assert sut.contents == 'ToasterSystemAdvShell.hh: models/ToasterSystem.dzn models/IToaster.dzn\n'
@@ -10,7 +10,7 @@ import pytest
 
 # system-under-test
 from dznpy.adv_shell import PortSelect, PortWildcard, PortCfg, all_sts_all_mts, \
-    all_mts_all_sts, all_mts_mixed_ts, all_sts_mixed_ts, all_mts, PortsSemanticsCfg
+    all_mts_all_sts, all_mts_mixed_ts, all_sts_mixed_ts, all_mts, PortsSemanticsCfg, EventSelect
 from dznpy.adv_shell.types import AdvShellError, RuntimeSemantics
 
 # Test data
@@ -274,3 +274,57 @@ def test_match_fail():
     with pytest.raises(AdvShellError) as exc:
         cfg.match(provides_ports={'api'}, requires_ports=set())
     assert str(exc.value) == "Configured requires ports ['mts_glue', 'sts_glue'] not matched"
+
+
+def test_event_select_ok():
+    assert EventSelect({'api'}).value == {'api'}
+    assert EventSelect({'api', 'api.Start'}).tryget_strset() == {'api', 'api.Start'}
+    assert EventSelect(PortWildcard.ALL).tryget_strset() == set()
+    assert EventSelect(PortWildcard.NONE).is_not_empty() is False
+    assert EventSelect(PortWildcard.ALL).is_not_empty() is True
+    assert EventSelect({'api.Start'}).is_not_empty() is True
+
+
+def test_event_select_fail():
+    with pytest.raises(TypeError) as exc:
+        EventSelect(123)
+    assert str(exc.value) == 'wrong type assigned'
+
+    with pytest.raises(AdvShellError) as exc:
+        EventSelect(set())
+    assert str(exc.value) == 'strset must not be empty'
+
+    with pytest.raises(AdvShellError) as exc:
+        EventSelect(PortWildcard.REMAINING)
+    assert str(exc.value) == 'wildcard REMAINING is not supported for event selection'
+
+    for bogus in ['', 'api.', '.Start', 'api.Start.Again']:
+        with pytest.raises(AdvShellError) as exc:
+            EventSelect({bogus})
+        assert str(exc.value) == 'strset items must be formatted as "<port>" or "<port>.<event>"'
+
+
+def test_event_select_port_names():
+    assert EventSelect({'api', 'hal.Start', 'hal.Stop'}).port_names() == {'api', 'hal'}
+    assert EventSelect(PortWildcard.ALL).port_names() == set()
+
+
+def test_event_select_match():
+    assert EventSelect(PortWildcard.ALL).match('api', 'Start') is True
+    assert EventSelect(PortWildcard.NONE).match('api', 'Start') is False
+    assert EventSelect({'api'}).match('api', 'Start') is True
+    assert EventSelect({'api'}).match('hal', 'Start') is False
+    assert EventSelect({'hal.Start'}).match('hal', 'Start') is True
+    assert EventSelect({'hal.Start'}).match('hal', 'Stop') is False
+
+
+def test_event_select_is_explicit_event():
+    assert EventSelect({'hal.Start'}).is_explicit_event('hal', 'Start') is True
+    assert EventSelect({'hal'}).is_explicit_event('hal', 'Start') is False
+    assert EventSelect(PortWildcard.ALL).is_explicit_event('hal', 'Start') is False
+
+
+def test_event_select_stringification():
+    assert str(EventSelect(PortWildcard.ALL)) == 'All ports'
+    assert str(EventSelect(PortWildcard.NONE)) == 'None of the ports'
+    assert str(EventSelect({'hal.Stop', 'api'})) == "['api', 'hal.Stop']"
@@ -131,7 +131,7 @@ ToasterSystemAdvShell::ToasterSystemAdvShell(const dzn::locator& locator, const
         return m_dispatcher([&] { return m_encapsulee.cord.out.Connected(); });
     };
     m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
-        return m_dispatcher([&, exampleParameter] { return m_encapsulee.cord.out.Disconnected(exampleParameter); });
+        return m_dispatcher([&, exampleParameter = std::move(exampleParameter)]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
     };
     m_rpLed.out.GlitchOccurred = [&] {
         return m_dispatcher([&] { return m_encapsulee.led.out.GlitchOccurred(); });
@@ -508,7 +508,7 @@ ToasterSystemAdvShell::ToasterSystemAdvShell(const dzn::locator& prototypeLocato
         return m_dispatcher([&] { return m_encapsulee.cord.out.Connected(); });
     };
     m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
-        return m_dispatcher([&, exampleParameter] { return m_encapsulee.cord.out.Disconnected(exampleParameter); });
+        return m_dispatcher([&, exampleParameter = std::move(exampleParameter)]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
     };
 }
 
@@ -862,7 +862,7 @@ ToasterSystemAdvShell::ToasterSystemAdvShell(const dzn::locator& prototypeLocato
         return m_dispatcher([&] { return m_encapsulee.cord.out.Connected(); });
     };
     m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
-        return m_dispatcher([&, exampleParameter] { return m_encapsulee.cord.out.Disconnected(exampleParameter); });
+        return m_dispatcher([&, exampleParameter = std::move(exampleParameter)]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
     };
     m_rpLed.out.GlitchOccurred = [&] {
         return m_dispatcher([&] { return m_encapsulee.led.out.GlitchOccurred(); });
@@ -918,3 +918,450 @@ dzn::locator& ToasterSystemAdvShell::Locator()
 } // namespace My::Project
 // Generated by: dznpy/adv_shell v0.3.240415
 '''
+
+CONFIG_LINE_ASYNC_ALL = '''\
+// - Port semantics: provides/requires: All MTS
+// - Asynchronous in-events: All ports
+'''
+
+CC_ASYNC_ALL_IN_EVENTS = '''\
+    // Reroute in-events of boundary provides ports (MTS) via the dispatcher
+    m_ppApi.in.Initialize = [&] {
+        return m_dispatcher([&] { return m_encapsulee.api.in.Initialize(); });
+    };
+    m_ppApi.in.Uninitialize = [&] {
+        return m_dispatcher([&] { return m_encapsulee.api.in.Uninitialize(); });
+    };
+    m_ppApi.in.SetTime = [&](size_t toastingTime) {
+        return m_dispatcher([&, toastingTime = std::move(toastingTime)]() mutable { return m_encapsulee.api.in.SetTime(std::move(toastingTime)); });
+    };
+    m_ppApi.in.GetTime = [&](size_t& toastingTime) {
+        return dzn::shell(m_dispatcher, [&] { return m_encapsulee.api.in.GetTime(toastingTime); });
+    };
+    m_ppApi.in.Toast = [&](std::string motd, PResultInfo& info) {
+        return dzn::shell(m_dispatcher, [&, motd] { return m_encapsulee.api.in.Toast(motd, info); });
+    };
+    m_ppApi.in.Cancel = [&] {
+        return m_dispatcher([&] { return m_encapsulee.api.in.Cancel(); });
+    };
+    m_ppApi.in.Recover = [&] {
+        return dzn::shell(m_dispatcher, [&] { return m_encapsulee.api.in.Recover(); });
+    };
+'''
+
+CC_ASYNC_SELECTED_IN_EVENTS = '''\
+    m_ppApi.in.Initialize = [&] {
+        return dzn::shell(m_dispatcher, [&] { return m_encapsulee.api.in.Initialize(); });
+    };
+    m_ppApi.in.Uninitialize = [&] {
+        return dzn::shell(m_dispatcher, [&] { return m_encapsulee.api.in.Uninitialize(); });
+    };
+    m_ppApi.in.SetTime = [&](size_t toastingTime) {
+        return m_dispatcher([&, toastingTime = std::move(toastingTime)]() mutable { return m_encapsulee.api.in.SetTime(std::move(toastingTime)); });
+    };
+'''
+
+CONFIG_LINE_ZERO_ALLOC = '''\
+// - Asynchronous in-events: ['api.Cancel']
+// - Event rerouting: zero heap allocations
+'''
+
+HH_INCLUDES_ZERO_ALLOC = '''\
+// Project includes
+#include "ToasterSystem.hh"
+#include "Dzn_StrictPort.hh"
+#include "Dzn_InplaceCallable.hh"
+'''
+
+CC_ZERO_ALLOC_IN_EVENTS = '''\
+    m_ppApi.in.SetTime = ::Dzn::Inplace([this](size_t toastingTime) {
+        return ::Dzn::InplaceShell(m_dispatcher, [&] { return m_encapsulee.api.in.SetTime(toastingTime); });
+    });
+    m_ppApi.in.GetTime = ::Dzn::Inplace([this](size_t& toastingTime) {
+        return ::Dzn::InplaceShell(m_dispatcher, [&] { return m_encapsulee.api.in.GetTime(toastingTime); });
+    });
+    m_ppApi.in.Toast = ::Dzn::Inplace([this](std::string motd, PResultInfo& info) {
+        return ::Dzn::InplaceShell(m_dispatcher, [&] { return m_encapsulee.api.in.Toast(motd, info); });
+    });
+    m_ppApi.in.Cancel = ::Dzn::Inplace([this] {
+        return m_dispatcher(::Dzn::Inplace([this] { return m_encapsulee.api.in.Cancel(); }));
+    });
+'''
+
+CC_ZERO_ALLOC_OUT_EVENTS = '''\
+    // Reroute out-events of boundary requires ports (MTS) via the dispatcher
+    m_rpCord.out.Connected = ::Dzn::Inplace([this] {
+        return m_dispatcher(::Dzn::Inplace([this] { return m_encapsulee.cord.out.Connected(); }));
+    });
+    m_rpCord.out.Disconnected = ::Dzn::Inplace([this](Sub::MyLongNamedType exampleParameter) {
+        return m_dispatcher(::Dzn::Inplace([this, exampleParameter] { return m_encapsulee.cord.out.Disconnected(exampleParameter); }));
+    });
+'''
+
+CONFIG_LINE_BATCHED = '''\
+// - Batched out-events: ['cord'] (flush: Explicit)
+'''
+
+HH_BATCHER_MEMBER = '''\
+    dzn::locator m_locator;
+
+    // Batching of out-events
+    ::Dzn::EventBatcher<dzn::pump> m_eventBatcher;
+
+    static const dzn::locator& FacilitiesCheck(const dzn::locator& locator);
+'''
+
+CC_BATCHER_MIL = '''\
+    : m_locator(std::move(FacilitiesCheck(prototypeLocator).clone().set(m_runtime).set(m_dispatcher)))
+    , m_eventBatcher(m_dispatcher, ::Dzn::BatchFlush::Explicit)
+    , m_encapsulee(m_locator)
+'''
+
+CC_BATCHED_IN_EVENTS = '''\
+    m_ppApi.in.SetTime = [&](size_t toastingTime) {
+        return m_eventBatcher.Shell([&, toastingTime] { return m_encapsulee.api.in.SetTime(toastingTime); });
+    };
+'''
+
+CC_BATCHED_OUT_EVENTS = '''\
+    m_rpCord.out.Connected = [&] {
+        return m_eventBatcher.Batch([&] { return m_encapsulee.cord.out.Connected(); });
+    };
+    m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
+        return m_eventBatcher.Batch([&, exampleParameter = std::move(exampleParameter)]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
+    };
+    m_rpLed.out.GlitchOccurred = [&] {
+        return m_eventBatcher([&] { return m_encapsulee.led.out.GlitchOccurred(); });
+    };
+'''
+
+CC_FLUSH_OUT_EVENTS = '''\
+void ToasterSystemAdvShell::FlushOutEvents()
+{
+    m_eventBatcher.Flush();
+}
+'''
+
+HH_STATISTICS_MEMBER = '''\
+    // Instrumentation of events
+    ::Dzn::EventStatistics m_statistics;
+'''
+
+CC_INSTRUMENTED_IN_EVENTS = '''\
+    m_ppApi.in.SetTime = [&, counters = &m_statistics.Register("api", "SetTime")](size_t toastingTime) {
+        return dzn::shell(m_dispatcher, [&, toastingTime, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.SetTime(toastingTime); });
+    };
+    m_ppApi.in.GetTime = [&, counters = &m_statistics.Register("api", "GetTime")](size_t& toastingTime) {
+        return dzn::shell(m_dispatcher, [&, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.GetTime(toastingTime); });
+    };
+'''
+
+CC_INSTRUMENTED_OUT_EVENTS = '''\
+    m_rpCord.out.Disconnected = [&, counters = &m_statistics.Register("cord", "Disconnected")](Sub::MyLongNamedType exampleParameter) {
+        return m_dispatcher([&, exampleParameter = std::move(exampleParameter), raised = m_statistics.Raised()]() mutable { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
+    };
+'''
+
+CC_STATISTICS_ACCESSOR = '''\
+const ::Dzn::EventStatistics& ToasterSystemAdvShell::Statistics() const
+{
+    return m_statistics;
+}
+'''
+
+CC_COMPILE_TIME_WIRING_FINAL_CONSTRUCT = '''\
+void ToasterSystemAdvShell::FinalConstruct(const dzn::meta* parentComponentMeta)
+{
+    // Check at compile-time that the ports of the encapsulated component match the generated boundary ports
+    static_assert(std::is_same<decltype(m_encapsulee.api), ::My::Project::IToaster>::value, "Port api of the encapsulee mismatches, regenerate the Advanced Shell");
+    static_assert(std::is_same<decltype(m_encapsulee.heaterElement), ::Some::Vendor::IHeaterElement>::value, "Port heaterElement of the encapsulee mismatches, regenerate the Advanced Shell");
+    static_assert(std::is_same<decltype(m_encapsulee.cord), ::My::Project::Hal::IPowerCord>::value, "Port cord of the encapsulee mismatches, regenerate the Advanced Shell");
+    static_assert(std::is_same<decltype(m_encapsulee.led), ::My::ILed>::value, "Port led of the encapsulee mismatches, regenerate the Advanced Shell");
+
+    // Check the bindings of all boundary ports
+    m_ppApi.check_bindings();
+    m_rpHeaterElement.check_bindings();
+    m_rpCord.check_bindings();
+    m_rpLed.check_bindings();
+
+    // Move the out-functors of the boundary provides-ports (MTS) to the respective ports of the encapsulated component
+    m_encapsulee.api.out = std::move(m_ppApi.out);
+
+    // Move the in-functors of the boundary requires-ports (MTS) to the respective ports of the encapsulated component
+    m_encapsulee.heaterElement.in = std::move(m_rpHeaterElement.in);
+    m_encapsulee.cord.in = std::move(m_rpCord.in);
+    m_encapsulee.led.in = std::move(m_rpLed.in);
+
+    // Complete the encapsulated component meta information (its ports are all wired and checked above)
+    m_encapsulee.dzn_meta.parent = parentComponentMeta;
+}
+'''
+
+HH_DISPATCHER_THREAD_MEMBER = '''\
+    // Thread of the dispatcher (same-thread bypass)
+    std::atomic<std::thread::id> m_dispatcherThread;
+
+'''
+
+CC_BYPASSED_IN_EVENT = '''\
+    m_ppApi.in.SetTime = [&, counters = &m_statistics.Register("api", "SetTime")](size_t toastingTime) {
+        if (m_dispatcherThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) { auto probe = m_statistics.Bypassed(*counters); return m_encapsulee.api.in.SetTime(toastingTime); }
+        return dzn::shell(m_dispatcher, [&, toastingTime, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.SetTime(toastingTime); });
+    };
+'''
+
+CC_RECORD_DISPATCHER_THREAD = '''\
+    // Record the dispatcher thread, in-events raised on it bypass the dispatcher (until handled, all in-events are dispatched)
+    m_dispatcher([this] { m_dispatcherThread.store(std::this_thread::get_id(), std::memory_order_relaxed); });
+}
+'''
+
+HH_BOUNDED_DISPATCHER_MEMBER = '''\
+    // Bounded admission of events to the dispatcher
+    ::Dzn::BoundedDispatcher<dzn::pump> m_boundedDispatcher;
+
+'''
+
+CC_BOUNDED_IN_EVENTS = '''\
+    m_ppApi.in.Toast = [&, counters = &m_statistics.Register("api", "Toast")](std::string motd, PResultInfo& info) {
+        return m_boundedDispatcher.Shell([&, motd, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.Toast(motd, info); });
+    };
+    m_ppApi.in.Cancel = [&, counters = &m_statistics.Register("api", "Cancel")] {
+        return m_boundedDispatcher([&, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.Cancel(); });
+    };
+'''
+
+CC_BOUNDED_OUT_EVENT = '''\
+    m_rpCord.out.Connected = [&, counters = &m_statistics.Register("cord", "Connected")] {
+        return m_boundedDispatcher([&, raised = m_statistics.Raised()] { auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.cord.out.Connected(); });
+    };
+'''
+
+CC_DISPATCHER_QUEUE_ACCESSOR = '''\
+const ::Dzn::BoundedDispatcher<dzn::pump>& ToasterSystemAdvShell::DispatcherQueue() const
+{
+    return m_boundedDispatcher;
+}
+'''
+
+HH_PRIORITY_LANES_MEMBER = '''\
+    // Prioritized dispatching of events
+    ::Dzn::PriorityLanes<dzn::pump> m_priorityLanes;
+
+'''
+
+CC_PRIORITY_IN_EVENTS = '''\
+    m_ppApi.in.Toast = [&](std::string motd, PResultInfo& info) {
+        if (m_dispatcherThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) { return m_encapsulee.api.in.Toast(motd, info); }
+        return m_priorityLanes.Shell([&, motd] { return m_encapsulee.api.in.Toast(motd, info); });
+    };
+    m_ppApi.in.Cancel = [&] {
+        return m_priorityLanes.Priority([&] { return m_encapsulee.api.in.Cancel(); });
+    };
+'''
+
+CC_PRIORITY_OUT_EVENTS = '''\
+    m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
+        return m_priorityLanes([&, exampleParameter = std::move(exampleParameter)]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
+    };
+    m_rpLed.out.GlitchOccurred = [&] {
+        return m_priorityLanes.Priority([&] { return m_encapsulee.led.out.GlitchOccurred(); });
+    };
+'''
+
+HH_SHARDED_MEMBERS = '''\
+private:
+    // Facilities of shard 1 (instances: sut, t1)
+    dzn::runtime m_runtime1;
+    dzn::pump m_dispatcher1;
+    dzn::locator m_locator1;
+
+    // Facilities of shard 2 (instances: t2)
+    dzn::runtime m_runtime2;
+    dzn::pump m_dispatcher2;
+    dzn::locator m_locator2;
+    static const dzn::locator& FacilitiesCheck(const dzn::locator& locator);
+
+    // The instances of the encapsulated system "ToasterTimers", per shard
+    // - shard 1
+    ::My::Project::Toaster m_sut;
+    ::Facilities::Timer m_t1;
+    // - shard 2
+    ::Facilities::Timer m_t2;
+'''
+
+CC_SHARDED_CONSTRUCTOR = '''\
+ToasterSystemAdvShell::ToasterSystemAdvShell(const dzn::locator& prototypeLocator, const std::string& encapsuleeInstanceName)
+    : m_locator1(std::move(FacilitiesCheck(prototypeLocator).clone().set(m_runtime1).set(m_dispatcher1)))
+    , m_locator2(std::move(FacilitiesCheck(prototypeLocator).clone().set(m_runtime2).set(m_dispatcher2)))
+    , m_sut(m_locator1)
+    , m_t1(m_locator1)
+    , m_t2(m_locator2)
+    , m_ppApi(m_sut.api)
+    , m_ppTimer(m_t2.api)
+    , m_rpHeaterElement(m_sut.heater)
+    , m_rpCord(m_sut.cord)
+    , m_rpLed(m_sut.led)
+{
+    // Complete the component meta info of the instances and their ports that are configured for MTS
+    const std::string prefix = encapsuleeInstanceName.empty() ? "" : encapsuleeInstanceName + ".";
+    m_sut.dzn_meta.name = prefix + "sut";
+    m_t1.dzn_meta.name = prefix + "t1";
+    m_t2.dzn_meta.name = prefix + "t2";
+    m_sut.api.meta.require.name = "api";
+    m_t2.api.meta.require.name = "timer";
+    m_sut.heater.meta.provide.name = "heaterElement";
+    m_sut.cord.meta.provide.name = "cord";
+    m_sut.led.meta.provide.name = "led";
+
+    // Connect the internal ports of the instances (within their shard)
+    dzn::connect(m_t1.api, m_sut.timer);
+'''
+
+CC_SHARDED_IN_EVENTS = '''\
+    m_ppTimer.in.Create = [&](size_t waitingTimeMs) {
+        return dzn::shell(m_dispatcher2, [&, waitingTimeMs] { return m_t2.api.in.Create(waitingTimeMs); });
+    };
+    m_ppTimer.in.Cancel = [&] {
+        return m_dispatcher2([&] { return m_t2.api.in.Cancel(); });
+    };
+'''
+
+CC_SHARDED_FINAL_CONSTRUCT = '''\
+    // Copy the out-functors of the boundary provides-ports (MTS) to the respective ports of the instances
+    m_sut.api.out = m_ppApi.out;
+    m_t2.api.out = m_ppTimer.out;
+
+    // Copy the in-functors of the boundary requires-ports (MTS) to the respective ports of the instances
+    m_sut.heater.in = m_rpHeaterElement.in;
+    m_sut.cord.in = m_rpCord.in;
+    m_sut.led.in = m_rpLed.in;
+
+    // Complete the meta information of the instances and check the bindings of all their ports
+    m_sut.dzn_meta.parent = parentComponentMeta;
+    m_t1.dzn_meta.parent = parentComponentMeta;
+    m_t2.dzn_meta.parent = parentComponentMeta;
+    m_sut.check_bindings();
+    m_t1.check_bindings();
+    m_t2.check_bindings();
+}
+'''
+
+HH_AWAITABLE_API = '''\
+    // Awaitable in-events of the provides ports (MTS), the coroutine resumes via the resumer (default: on the dispatcher thread)
+    struct AsyncApi
+    {
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Initialize)::result_type> Initialize();
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Uninitialize)::result_type> Uninitialize();
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.SetTime)::result_type> SetTime(size_t toastingTime);
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.GetTime)::result_type> GetTime(size_t& toastingTime);
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Toast)::result_type> Toast(std::string motd, PResultInfo& info);
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Cancel)::result_type> Cancel();
+        ::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Recover)::result_type> Recover();
+        ToasterSystemAdvShell* m_shell;
+        ::Dzn::AwaitableResumer m_resumer;
+    };
+    ToasterSystemAdvShell::AsyncApi AsyncProvidesApi(::Dzn::AwaitableResumer resumer = nullptr);
+'''
+
+CC_AWAITABLE_API = '''\
+ToasterSystemAdvShell::AsyncApi ToasterSystemAdvShell::AsyncProvidesApi(::Dzn::AwaitableResumer resumer)
+{
+    return {this, std::move(resumer)};
+}
+
+::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Initialize)::result_type> ToasterSystemAdvShell::AsyncApi::Initialize()
+{
+    return {m_shell->m_dispatcher, [shell = m_shell] { return shell->m_encapsulee.api.in.Initialize(); }, m_resumer};
+}
+
+::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Uninitialize)::result_type> ToasterSystemAdvShell::AsyncApi::Uninitialize()
+{
+    return {m_shell->m_dispatcher, [shell = m_shell] { return shell->m_encapsulee.api.in.Uninitialize(); }, m_resumer};
+}
+
+::Dzn::Awaitable<decltype(::My::Project::IToaster::in.SetTime)::result_type> ToasterSystemAdvShell::AsyncApi::SetTime(size_t toastingTime)
+{
+    return {m_shell->m_dispatcher, [shell = m_shell, toastingTime] { return shell->m_encapsulee.api.in.SetTime(toastingTime); }, m_resumer};
+}
+
+::Dzn::Awaitable<decltype(::My::Project::IToaster::in.GetTime)::result_type> ToasterSystemAdvShell::AsyncApi::GetTime(size_t& toastingTime)
+{
+    return {m_shell->m_dispatcher, [shell = m_shell, &toastingTime] { return shell->m_encapsulee.api.in.GetTime(toastingTime); }, m_resumer};
+}
+
+::Dzn::Awaitable<decltype(::My::Project::IToaster::in.Toast)::result_type> ToasterSystemAdvShell::AsyncApi::Toast(std::string motd, PResultInfo& info)
+{
+    return {m_shell->m_dispatcher, [shell = m_shell, motd, &info] { return shell->m_encapsulee.api.in.Toast(motd, info); }, m_resumer};
+}
+'''
+
+CC_SHARED_BUFFER_OUT_EVENT = '''\
+    m_rpCord.out.Disconnected = [&](Sub::MyLongNamedType exampleParameter) {
+        return m_dispatcher([&, exampleParameter = std::make_shared<Sub::MyLongNamedType>(std::move(exampleParameter))]() mutable { return m_encapsulee.cord.out.Disconnected(std::move(*exampleParameter)); });
+    };
+'''
+
+CC_REROUTE_HELPERS_IN_EVENTS = '''\
+    // Reroute in-events of boundary provides ports (MTS) via the dispatcher
+    m_ppApi.in.Initialize = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.api.in.Initialize);
+    m_ppApi.in.Uninitialize = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.api.in.Uninitialize);
+    m_ppApi.in.SetTime = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.api.in.SetTime);
+    m_ppApi.in.GetTime = ::Dzn::RerouteShell(m_dispatcher, m_encapsulee.api.in.GetTime);
+    m_ppApi.in.Toast = ::Dzn::RerouteShell(m_dispatcher, m_encapsulee.api.in.Toast);
+    m_ppApi.in.Cancel = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.api.in.Cancel);
+    m_ppApi.in.Recover = ::Dzn::RerouteShell(m_dispatcher, m_encapsulee.api.in.Recover);
+'''
+
+CC_REROUTE_HELPERS_OUT_EVENTS = '''\
+    // Reroute out-events of boundary requires ports (MTS) via the dispatcher
+    m_rpCord.out.Connected = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.cord.out.Connected);
+    m_rpCord.out.Disconnected = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.cord.out.Disconnected);
+    m_rpLed.out.GlitchOccurred = ::Dzn::ReroutePost(m_dispatcher, m_encapsulee.led.out.GlitchOccurred);
+'''
+
+HH_HEADER_ONLY_INCLUDES = '''\
+// System includes
+#include <dzn/locator.hh>
+#include <dzn/pump.hh>
+#include <dzn/runtime.hh>
+#include <type_traits>
+#include <utility>
+// Project includes
+#include "ToasterSystem.hh"
+#include "Dzn_StrictPort.hh"
+'''
+
+HH_HEADER_ONLY_DEFINITIONS = '''\
+    ::My::ILed m_rpLed;
+};
+
+inline const dzn::locator& ToasterSystemAdvShell::FacilitiesCheck(const dzn::locator& locator)
+{
+'''
+
+CC_EVENT_TRACE_IN_EVENTS = '''\
+    m_ppApi.in.Toast = [&, point = ::Dzn::EventTrace::Register("ToasterSystemAdvShell.api", "Toast")](std::string motd, PResultInfo& info) {
+        ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Enqueue);
+        return dzn::shell(m_dispatcher, [&, motd, point] { ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Dequeue); return m_encapsulee.api.in.Toast(motd, info); });
+    };
+    m_ppApi.in.Cancel = [&, point = ::Dzn::EventTrace::Register("ToasterSystemAdvShell.api", "Cancel")] {
+        ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Enqueue);
+        return m_dispatcher([&, point] { ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Dequeue); return m_encapsulee.api.in.Cancel(); });
+    };
+'''
+
+CC_EVENT_TRACE_OUT_EVENTS = '''\
+    m_rpCord.out.Disconnected = [&, point = ::Dzn::EventTrace::Register("ToasterSystemAdvShell.cord", "Disconnected")](Sub::MyLongNamedType exampleParameter) {
+        ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Enqueue);
+        return m_dispatcher([&, exampleParameter = std::move(exampleParameter), point]() mutable { ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Dequeue); return m_encapsulee.cord.out.Disconnected(std::move(exampleParameter)); });
+    };
+'''
+
+CC_EVENT_TRACE_INSTRUMENTED_BYPASS = '''\
+    m_ppApi.in.GetTime = [&, counters = &m_statistics.Register("api", "GetTime"), point = ::Dzn::EventTrace::Register("ToasterSystemAdvShell.api", "GetTime")](size_t& toastingTime) {
+        ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Enqueue);
+        if (m_dispatcherThread.load(std::memory_order_relaxed) == std::this_thread::get_id()) { ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Dequeue); auto probe = m_statistics.Bypassed(*counters); return m_encapsulee.api.in.GetTime(toastingTime); }
+        return dzn::shell(m_dispatcher, [&, raised = m_statistics.Raised(), point] { ::Dzn::EventTrace::Record(point, ::Dzn::TracePhase::Dequeue); auto probe = m_statistics.Handling(*counters, raised); return m_encapsulee.api.in.GetTime(toastingTime); });
+    };
+'''
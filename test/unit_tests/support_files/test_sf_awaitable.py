@@ -0,0 +1,161 @@
+"""
+Testsuite validating the output of generated support file: Awaitable.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import awaitable as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Awaitable
+//
+// Description: a C++20 coroutine awaitable that posts a job to a dispatcher (like dzn::pump) when
+//              the awaiting coroutine suspends, and resumes the coroutine with the reply of the job
+//              once it has been executed. As opposed to dzn::shell, no thread is blocked while the
+//              job is pending.
+//
+// Resumer: by default (no resumer) the coroutine is resumed on the dispatcher thread. Hence it
+//          must not raise a blocking (dzn::shell) in-event of a component on that same dispatcher
+//          before it has moved on to an other thread, and it occupies the dispatcher until it
+//          suspends again. Awaiting an other Awaitable is fine. Specify an AwaitableResumer to
+//          resume the coroutine on an executor of the caller instead, e.g. by posting the handle
+//          to the event loop or thread pool of the caller. The dispatcher then solely executes the
+//          job.
+//
+// Note: an exception thrown by the job is rethrown by co_await.
+//
+// Example:
+//
+//    """ f'{ns_prefix}' """Dzn::Awaitable<int> GetValue(dzn::pump& pump, MyComponent& comp)
+//    {
+//        return {pump, [&comp] { return comp.api.in.GetValue(); }};
+//    }
+//
+//    MyTask Example(dzn::pump& pump, MyComponent& comp)
+//    {
+//        int value = co_await GetValue(pump, comp);
+//    }
+//
+//    """ f'{ns_prefix}' """Dzn::Awaitable<int> GetValueOnLoop(dzn::pump& pump, MyComponent& comp, MyEventLoop& loop)
+//    {
+//        return {pump, [&comp] { return comp.api.in.GetValue(); },
+//                [&loop](std::coroutine_handle<> handle) { loop.Post([handle] { handle.resume(); }); }};
+//    }
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+// Resumes the awaiting coroutine on the executor of the caller, instead of on the dispatcher thread
+using AwaitableResumer = std::function<void(std::coroutine_handle<>)>;
+
+template <typename RESULT>
+class Awaitable
+{
+public:
+    template <typename DISPATCHER, typename CALLABLE>
+    Awaitable(DISPATCHER& dispatcher, CALLABLE&& callable, AwaitableResumer resumer = nullptr)
+        : m_dispatcher(&dispatcher)
+        , m_post([](void* dispatcher, std::function<void()> job) { (*static_cast<DISPATCHER*>(dispatcher))(std::move(job)); })
+        , m_callable(std::forward<CALLABLE>(callable))
+        , m_resumer(std::move(resumer))
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiter)
+    {
+        // the coroutine might be resumed (and this awaitable destroyed) before posting returns
+        auto post = m_post;
+        post(m_dispatcher, [this, awaiter] {
+            try
+            {
+                if constexpr (std::is_void_v<RESULT>) m_callable();
+                else m_result.emplace(m_callable());
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+            if (!m_resumer) return awaiter.resume();
+            auto resumer = std::move(m_resumer); // the resumer might destroy this awaitable
+            resumer(awaiter);
+        });
+    }
+
+    RESULT await_resume()
+    {
+        if (m_exception) std::rethrow_exception(m_exception);
+        if constexpr (!std::is_void_v<RESULT>) return std::move(*m_result);
+    }
+
+private:
+    struct Empty
+    {
+    };
+    using Storage = std::conditional_t<std::is_void_v<RESULT>, Empty, RESULT>;
+
+    void* m_dispatcher;
+    void (*m_post)(void*, std::function<void()>);
+    std::function<RESULT()> m_callable;
+    AwaitableResumer m_resumer;
+    std::optional<Storage> m_result;
+    std::exception_ptr m_exception;
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_Awaitable.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == 'd5ce581b1abd498bd8c412eb327a4ec0'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_Awaitable.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
@@ -0,0 +1,291 @@
+"""
+Testsuite validating the output of generated support file: Bounded Dispatcher.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import bounded_dispatcher as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Bounded Dispatcher
+//
+// Description: a front-end of a dispatcher (like dzn::pump) that admits jobs into a bounded
+//              lock-free ring buffer (multi-producer, multi-consumer). The ring buffer is drained on
+//              the dispatcher thread by a single drain job that is posted when the ring buffer turns
+//              non-empty. Hence the memory and the number of pending jobs stay bounded when the
+//              dispatcher falls behind, whereas the queue of the dispatcher itself is unbounded.
+//              The jobs are executed in the order of admission. A drain job executes at most
+//              Capacity() jobs and then re-posts itself, so that other jobs of the dispatcher are
+//              not starved by a steady stream of admitted jobs.
+//
+// Overflow behaviour when the ring buffer is full:
+// - Block:      the producer yields until a slot is available. It must not be used on the
+//               dispatcher thread itself, because then the ring buffer is never drained.
+// - DropOldest: the oldest pending job is discarded (and counted) to admit the new job.
+// - Reject:     the new job is discarded (and counted), operator() replies false.
+//
+// Shell() blocks until the job has been executed (like dzn::shell) and therefore always waits for
+// a free slot, regardless of the overflow behaviour. When its job is dropped by DropOldest, Shell()
+// throws std::future_error (broken promise).
+//
+// Example:
+//
+//    """ f'{ns_prefix}' """Dzn::BoundedDispatcher<dzn::pump> dispatcher(myPump, 1024, """ f'{ns_prefix}' """Dzn::DispatcherOverflow::DropOldest);
+//
+//    dispatcher([&] { myComp.hal.out.Sample(1); });
+//    auto result = dispatcher.Shell([&] { return myComp.api.in.GetState(); }); // blocking, like dzn::shell
+//    std::cout << "Dropped: " << dispatcher.Dropped() << std::endl;
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+enum class DispatcherOverflow
+{
+    Block,
+    DropOldest,
+    Reject
+};
+
+template <typename DISPATCHER>
+class BoundedDispatcher
+{
+public:
+    using Job = std::function<void()>;
+
+    // The capacity is rounded up to a power of 2 (minimum 2)
+    BoundedDispatcher(DISPATCHER& dispatcher, std::size_t capacity, DispatcherOverflow overflow)
+        : m_dispatcher(dispatcher)
+        , m_overflow(overflow)
+        , m_ring(std::make_shared<Ring>(capacity))
+    {
+    }
+
+    BoundedDispatcher(const BoundedDispatcher&) = delete;
+    BoundedDispatcher& operator=(const BoundedDispatcher&) = delete;
+
+    // Admit a job according to the overflow behaviour, replies whether it has been admitted
+    bool operator()(Job job)
+    {
+        return Admit(std::move(job), m_overflow);
+    }
+
+    // Admit a job and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto Shell(CALLABLE&& callable) -> decltype(callable())
+    {
+        using RESULT = decltype(callable());
+        auto promise = std::make_shared<std::promise<RESULT>>();
+        auto future = promise->get_future();
+        Admit([&callable, promise] {
+            if constexpr (std::is_void_v<RESULT>) { callable(); promise->set_value(); }
+            else promise->set_value(callable());
+        }, DispatcherOverflow::Block);
+        return future.get();
+    }
+
+    std::size_t Capacity() const { return m_ring->mask + 1; }
+    std::uint64_t Dropped() const { return m_ring->dropped.load(std::memory_order_relaxed); }
+    std::uint64_t Rejected() const { return m_ring->rejected.load(std::memory_order_relaxed); }
+
+private:
+    // Lock-free ring buffer (sequence numbered cells), shared with the pending drain job. It has
+    // multiple consumers: the drain job, and with DropOldest the producers that discard the oldest
+    // job in Admit(). TryPop() is safe for concurrent consumers, because a consumer claims a cell by
+    // the compare-exchange of dequeuePos: only the winner moves the job out of the cell, and it
+    // hands the cell back to the producers by the release store of its sequence. A loser reloads
+    // dequeuePos and retries on the next cell. Hence a job is either executed or dropped, once.
+    struct Ring
+    {
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            Job job;
+        };
+
+        explicit Ring(std::size_t capacity)
+            : mask(RoundUpPow2(capacity) - 1)
+            , cells(new Cell[mask + 1])
+        {
+            for (std::size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        static std::size_t RoundUpPow2(std::size_t value)
+        {
+            std::size_t result = 2;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        // Enqueue a job, replies false when full
+        bool TryPush(Job& job)
+        {
+            auto pos = enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells[pos & mask];
+                auto diff = static_cast<std::intptr_t>(cell.sequence.load(std::memory_order_acquire)) -
+                            static_cast<std::intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.job = std::move(job);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) return false;
+                else pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Dequeue the oldest job, replies false when empty
+        bool TryPop(Job& job)
+        {
+            auto pos = dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells[pos & mask];
+                auto diff = static_cast<std::intptr_t>(cell.sequence.load(std::memory_order_acquire)) -
+                            static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        job = std::move(cell.job);
+                        cell.job = nullptr;
+                        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) return false;
+                else pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Executed on the dispatcher thread, executes at most maxJobs jobs. Replies true when jobs
+        // remain, the drain job must then be re-posted (drainPosted is still set).
+        bool Drain(std::size_t maxJobs)
+        {
+            Job job;
+            for (std::size_t count = 0; count < maxJobs; ++count)
+            {
+                if (!TryPop(job))
+                {
+                    // re-check after clearing the flag, a job admitted meanwhile might not have observed it cleared
+                    drainPosted.store(false, std::memory_order_seq_cst);
+                    if (!TryPop(job)) return false;
+                    if (drainPosted.exchange(true, std::memory_order_seq_cst))
+                    {
+                        job(); // a new drain job has been posted meanwhile, it takes over
+                        return false;
+                    }
+                }
+                job();
+                job = nullptr;
+            }
+            return true;
+        }
+
+        const std::size_t mask;
+        std::unique_ptr<Cell[]> cells;
+        alignas(64) std::atomic<std::size_t> enqueuePos{0};
+        alignas(64) std::atomic<std::size_t> dequeuePos{0};
+        std::atomic<bool> drainPosted{false};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> rejected{0};
+    };
+
+    bool Admit(Job job, DispatcherOverflow overflow)
+    {
+        while (!m_ring->TryPush(job))
+        {
+            if (overflow == DispatcherOverflow::Reject)
+            {
+                m_ring->rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (overflow == DispatcherOverflow::DropOldest)
+            {
+                Job oldest;
+                if (m_ring->TryPop(oldest)) m_ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            else std::this_thread::yield();
+        }
+
+        // post a drain job unless one is pending already
+        if (!m_ring->drainPosted.exchange(true, std::memory_order_seq_cst)) PostDrain(m_dispatcher, m_ring);
+        return true;
+    }
+
+    // Post a drain job that co-owns the ring buffer, it re-posts itself while jobs remain
+    static void PostDrain(DISPATCHER& dispatcher, const std::shared_ptr<Ring>& ring)
+    {
+        dispatcher([&dispatcher, ring] {
+            if (ring->Drain(ring->mask + 1)) PostDrain(dispatcher, ring);
+        });
+    }
+
+    DISPATCHER& m_dispatcher;
+    const DispatcherOverflow m_overflow;
+    std::shared_ptr<Ring> m_ring;
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_BoundedDispatcher.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == 'cd5d0ee62cefdbcd012468f54b4df5cd'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_BoundedDispatcher.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
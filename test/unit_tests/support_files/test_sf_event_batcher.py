@@ -0,0 +1,180 @@
+"""
+Testsuite validating the output of generated support file: Event Batcher.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import event_batcher as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Event Batcher
+//
+// Description: a front-end of a dispatcher (like dzn::pump) that enqueues a burst of events as a
+//              single dispatcher job. This amortises the wake-ups of the dispatcher thread and the
+//              lock acquisitions of its queue. The events of a batch are executed in order.
+//
+// Flush modes:
+// - Burst:    the first event of a batch posts one drain job to the dispatcher. Succeeding events
+//             join the batch until the dispatcher starts executing the drain job.
+// - Explicit: the events are collected until Flush() is called, that posts the drain job.
+//
+// Ordering: every job that bypasses batching must be posted via operator() or Shell() of the
+//           Event Batcher. It seals the open batch first, which is then posted (if not yet) ahead
+//           of the job. Hence all events keep the order in which they were raised, as if they were
+//           posted to the dispatcher one by one.
+//
+// Example:
+//
+//    """ f'{ns_prefix}' """Dzn::EventBatcher<dzn::pump> batcher(myPump, """ f'{ns_prefix}' """Dzn::BatchFlush::Burst);
+//
+//    batcher.Batch([&] { myComp.hal.out.Sample(1); });
+//    batcher.Batch([&] { myComp.hal.out.Sample(2); });  // joins the batch of Sample(1)
+//    batcher([&] { myComp.hal.out.Stopped(); });        // seals the batch, then is posted itself
+//    auto result = batcher.Shell([&] { return myComp.api.in.GetState(); }); // blocking, like dzn::shell
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+enum class BatchFlush
+{
+    Burst,
+    Explicit
+};
+
+template <typename DISPATCHER>
+class EventBatcher
+{
+public:
+    using Job = std::function<void()>;
+
+    EventBatcher(DISPATCHER& dispatcher, BatchFlush flush)
+        : m_dispatcher(dispatcher)
+        , m_flush(flush)
+    {
+    }
+
+    // Enqueue an event to the open batch, or open a new batch
+    void Batch(Job event)
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_open)
+        {
+            m_open = std::make_shared<Events>();
+            if (m_flush == BatchFlush::Burst) PostDrain(m_open);
+        }
+        m_open->push_back(std::move(event));
+    }
+
+    // Post the open batch (Explicit flush mode) and close it
+    void Flush()
+    {
+        std::lock_guard lock(m_mutex);
+        Seal();
+    }
+
+    // Post a job that bypasses batching, while preserving the order with the batched events
+    void operator()(const Job& job)
+    {
+        std::lock_guard lock(m_mutex);
+        Seal();
+        m_dispatcher(job);
+    }
+
+    // Post a job that bypasses batching and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto Shell(CALLABLE&& callable) -> decltype(callable())
+    {
+        using RESULT = decltype(callable());
+        std::promise<RESULT> promise;
+        (*this)([&] {
+            if constexpr (std::is_void_v<RESULT>) { callable(); promise.set_value(); }
+            else promise.set_value(callable());
+        });
+        return promise.get_future().get();
+    }
+
+private:
+    using Events = std::vector<Job>;
+
+    // Precondition: m_mutex is locked
+    void Seal()
+    {
+        if (!m_open) return;
+        if (m_flush == BatchFlush::Explicit) PostDrain(m_open);
+        m_open.reset();
+    }
+
+    // Precondition: m_mutex is locked
+    void PostDrain(const std::shared_ptr<Events>& batch)
+    {
+        m_dispatcher([this, batch] {
+            {
+                std::lock_guard lock(m_mutex);
+                if (m_open == batch) m_open.reset(); // close the batch, later events open a new one
+            }
+            for (auto& event : *batch) event();
+        });
+    }
+
+    DISPATCHER& m_dispatcher;
+    const BatchFlush m_flush;
+    std::mutex m_mutex;
+    std::shared_ptr<Events> m_open; // the batch that accepts events, nullptr when none
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_EventBatcher.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == '3b4564b75bc2eb487beedb4da34ed843'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_EventBatcher.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
@@ -0,0 +1,214 @@
+"""
+Testsuite validating the output of generated support file: Event Statistics.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import event_statistics as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Event Statistics
+//
+// Description: lock-free instrumentation of events that are rerouted via a dispatcher (dzn::pump).
+//              Per registered port/event it counts the events and records two latencies in
+//              histograms with power-of-2 nanosecond buckets:
+//              - wait latency: from raising the event until the dispatcher starts handling it,
+//              - handle latency: the duration of handling the event by the encapsulee.
+//              Additionally the number of events queued at the dispatcher (queue depth) is tracked.
+//
+// Usage: register each event during construction with Register(). The returned EventCounters has a
+//        stable address. Per event, Raised() is called on the calling thread and its result is
+//        passed to a Handling() probe on the dispatcher thread, that records on destruction (RAII).
+//        An event handled directly on the dispatcher thread is probed with Bypassed() instead.
+//
+// Example:
+//
+//    """ f'{ns_prefix}' """Dzn::EventStatistics statistics;
+//    auto& counters = statistics.Register("api", "Start");
+//
+//    auto raised = statistics.Raised();
+//    dzn::shell(pump, [&] { auto probe = statistics.Handling(counters, raised); comp.api.in.Start(); });
+//
+//    statistics.Visit([](const std::string& port, const std::string& event, const auto& counters) {
+//        std::cout << port << "." << event << ": " << counters.count << std::endl;
+//    });
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+using StatisticsClock = std::chrono::steady_clock;
+
+// Histogram of durations where bucket i counts [2^i, 2^(i+1)) nanoseconds, the last bucket is unbounded
+struct LatencyHistogram
+{
+    static constexpr std::size_t NrBuckets = 40;
+
+    void Add(std::chrono::nanoseconds duration)
+    {
+        auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 1));
+        std::size_t bucket = 0;
+        while (ns >>= 1) ++bucket;
+        buckets[std::min(bucket, NrBuckets - 1)].fetch_add(1, std::memory_order_relaxed);
+
+        auto max = maxNs.load(std::memory_order_relaxed);
+        auto value = static_cast<std::uint64_t>(duration.count());
+        while (value > max && !maxNs.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+        totalNs.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, NrBuckets> buckets{};
+    std::atomic<std::uint64_t> totalNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+};
+
+struct EventCounters
+{
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> bypassed{0}; // handled directly on the dispatcher thread (included in count)
+    LatencyHistogram waitLatency;
+    LatencyHistogram handleLatency;
+};
+
+class EventStatistics
+{
+public:
+    // Records the handle latency and the count on destruction
+    class Probe
+    {
+    public:
+        Probe(EventCounters& counters, StatisticsClock::time_point started)
+            : m_counters(counters)
+            , m_started(started)
+        {
+        }
+
+        Probe(const Probe&) = delete;
+        Probe& operator=(const Probe&) = delete;
+
+        ~Probe()
+        {
+            m_counters.handleLatency.Add(StatisticsClock::now() - m_started);
+            m_counters.count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        EventCounters& m_counters;
+        const StatisticsClock::time_point m_started;
+    };
+
+    // Register a port/event, to be called during construction only
+    EventCounters& Register(const std::string& portName, const std::string& eventName)
+    {
+        auto& entry = m_entries.emplace_back();
+        entry.portName = portName;
+        entry.eventName = eventName;
+        return entry.counters;
+    }
+
+    // Mark an event as raised (and queued), to be called on the thread raising the event
+    StatisticsClock::time_point Raised()
+    {
+        auto depth = m_queueDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto max = m_maxQueueDepth.load(std::memory_order_relaxed);
+        while (depth > max && !m_maxQueueDepth.compare_exchange_weak(max, depth, std::memory_order_relaxed)) {}
+        return StatisticsClock::now();
+    }
+
+    // Mark the start of handling the event, to be called on the dispatcher thread
+    [[nodiscard]] Probe Handling(EventCounters& counters, StatisticsClock::time_point raised)
+    {
+        m_queueDepth.fetch_sub(1, std::memory_order_relaxed);
+        auto started = StatisticsClock::now();
+        counters.waitLatency.Add(started - raised);
+        return Probe(counters, started);
+    }
+
+    // Mark the start of handling an event that bypasses the dispatcher queue, because it is raised
+    // on the dispatcher thread itself (without a wait latency and without affecting the queue depth)
+    [[nodiscard]] Probe Bypassed(EventCounters& counters)
+    {
+        counters.bypassed.fetch_add(1, std::memory_order_relaxed);
+        return Probe(counters, StatisticsClock::now());
+    }
+
+    std::int64_t QueueDepth() const { return m_queueDepth.load(std::memory_order_relaxed); }
+    std::int64_t MaxQueueDepth() const { return m_maxQueueDepth.load(std::memory_order_relaxed); }
+
+    // Visit the counters of all registered port/events in order of registration
+    template <typename VISITOR>
+    void Visit(VISITOR&& visitor) const
+    {
+        for (const auto& entry : m_entries) visitor(entry.portName, entry.eventName, entry.counters);
+    }
+
+private:
+    struct Entry
+    {
+        std::string portName;
+        std::string eventName;
+        EventCounters counters;
+    };
+
+    std::deque<Entry> m_entries; // deque: stable addresses of the counters
+    std::atomic<std::int64_t> m_queueDepth{0};
+    std::atomic<std::int64_t> m_maxQueueDepth{0};
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_EventStatistics.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == 'cf812d7cb16c8bd04a82175227782a34'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_EventStatistics.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
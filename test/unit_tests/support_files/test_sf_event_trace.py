@@ -0,0 +1,281 @@
+"""
+Testsuite validating the output of generated support file: Event Trace.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import event_trace as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Event Trace
+//
+// Description: a process-wide trace of the events that cross the boundary of a shell, meant to be
+//              left enabled in production for post-mortem analysis (e.g. of a hang or deadline
+//              miss). Each thread records fixed-size binary records (timestamp, thread, port,
+//              event and phase) into its own lock-free ring buffer, which keeps the last
+//              TraceCapacity records. Recording a record costs a clock read and a few relaxed
+//              atomic stores; no strings are built and no locks are taken.
+//
+// Usage: register each traced port/event once (cold path) and record its phases (hot path). The
+//        registered names and the records of all threads are dumped in a binary format that is
+//        decoded by the python module dznpy/event_trace.py. A dump is meant to be taken post-mortem,
+//        a record that is overwritten while being dumped might be torn.
+//
+// Example:
+//
+//    auto point = """ f'{ns_prefix}' """Dzn::EventTrace::Register("MyShell.api", "Start");
+//    """ f'{ns_prefix}' """Dzn::EventTrace::Record(point, """ f'{ns_prefix}' """Dzn::TracePhase::Enqueue);
+//
+//    std::ofstream file("trace.bin", std::ios::binary);
+//    """ f'{ns_prefix}' """Dzn::EventTrace::Dump(file);
+//
+// The policy TracedSelect records the Select() and Deselect() of the clients of a MultiClientSelector:
+//
+//    """ f'{ns_prefix}' """Dzn::MultiClientSelector<IToaster, """ f'{ns_prefix}' """Dzn::MutexWrapped, """ f'{ns_prefix}' """Dzn::TracedSelect> m_selector;
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+using TraceClock = std::chrono::steady_clock;
+
+// Number of records a ring buffer of a thread keeps
+inline constexpr std::size_t TraceCapacity = 4096;
+
+// Phase of an event at the boundary of a shell
+enum class TracePhase : std::uint8_t
+{
+    Enqueue = 0,  // raised and posted to the dispatcher
+    Dequeue = 1,  // taken by the dispatcher to be handled
+    Select = 2,   // a client of a MultiClientSelector is selected
+    Deselect = 3  // a client of a MultiClientSelector is deselected
+};
+
+// Registered identification of a port and one of its events (or clients)
+struct TracePoint
+{
+    std::uint16_t port;
+    std::uint16_t event;
+};
+
+struct TraceRecord
+{
+    std::uint64_t timestamp; // nanoseconds of the TraceClock
+    std::uint32_t thread;    // number of the thread, in order of its first record
+    TracePoint point;
+    TracePhase phase;
+};
+
+struct TraceName
+{
+    TracePoint point;
+    std::string portName;
+    std::string eventName;
+};
+
+class EventTrace
+{
+public:
+    // Register a port/event, to be called during construction only. Equal names reply the same point.
+    static TracePoint Register(const std::string& portName, const std::string& eventName)
+    {
+        auto& state = Instance();
+        std::lock_guard lock(state.mutex);
+        auto port = state.ports.emplace(portName, std::make_pair(state.ports.size(), std::map<std::string, std::uint16_t>{}));
+        auto& events = port.first->second.second;
+        auto event = events.emplace(eventName, static_cast<std::uint16_t>(events.size()));
+        TracePoint point{static_cast<std::uint16_t>(port.first->second.first), event.first->second};
+        if (event.second) state.names.push_back({point, portName, eventName});
+        return point;
+    }
+
+    // Record a phase of an event in the ring buffer of the calling thread
+    static void Record(TracePoint point, TracePhase phase)
+    {
+        thread_local Ring& ring = Instance().CreateRing();
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(TraceClock::now().time_since_epoch());
+        auto head = ring.head.load(std::memory_order_relaxed);
+        auto& slot = ring.slots[head % TraceCapacity];
+        slot.timestamp.store(static_cast<std::uint64_t>(nanoseconds.count()), std::memory_order_relaxed);
+        slot.info.store(std::uint64_t{point.port} | std::uint64_t{point.event} << 16 | std::uint64_t(phase) << 32, std::memory_order_relaxed);
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+
+    // Get the registered names in order of registration
+    static std::vector<TraceName> Names()
+    {
+        auto& state = Instance();
+        std::lock_guard lock(state.mutex);
+        return state.names;
+    }
+
+    // Get the records of all threads ordered by their timestamp
+    static std::vector<TraceRecord> Records()
+    {
+        auto& state = Instance();
+        std::vector<TraceRecord> result;
+        std::lock_guard lock(state.mutex);
+        for (const auto& ring : state.rings)
+        {
+            auto head = ring->head.load(std::memory_order_acquire);
+            for (auto i = head > TraceCapacity ? head - TraceCapacity : 0; i < head; ++i)
+            {
+                const auto& slot = ring->slots[i % TraceCapacity];
+                auto info = slot.info.load(std::memory_order_relaxed);
+                result.push_back({slot.timestamp.load(std::memory_order_relaxed), ring->thread,
+                                  {static_cast<std::uint16_t>(info), static_cast<std::uint16_t>(info >> 16)}, static_cast<TracePhase>(info >> 32)});
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), [](const auto& a, const auto& b) { return a.timestamp < b.timestamp; });
+        return result;
+    }
+
+    // Write the names and records in the binary format (little-endian):
+    //   "DZNTRACE", u32 version, u32 nr of names, per name: u16 port, u16 event, u16 length + port name, u16 length + event name,
+    //   u32 nr of records, per record: u64 timestamp, u32 thread, u16 port, u16 event, u8 phase, 7 reserved bytes
+    static void Dump(std::ostream& os)
+    {
+        auto put = [&os](std::uint64_t value, int nrBytes) {
+            for (int i = 0; i < nrBytes; ++i) os.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        };
+        auto putString = [&](const std::string& value) {
+            put(value.size(), 2);
+            os.write(value.data(), static_cast<std::streamsize>(value.size()));
+        };
+
+        const auto names = Names();
+        const auto records = Records();
+        os.write("DZNTRACE", 8);
+        put(1, 4);
+        put(names.size(), 4);
+        for (const auto& name : names)
+        {
+            put(name.point.port, 2);
+            put(name.point.event, 2);
+            putString(name.portName);
+            putString(name.eventName);
+        }
+        put(records.size(), 4);
+        for (const auto& record : records)
+        {
+            put(record.timestamp, 8);
+            put(record.thread, 4);
+            put(record.point.port, 2);
+            put(record.point.event, 2);
+            put(static_cast<std::uint8_t>(record.phase), 1);
+            put(0, 7);
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> timestamp{0};
+        std::atomic<std::uint64_t> info{0}; // port | event << 16 | phase << 32
+    };
+
+    struct Ring
+    {
+        explicit Ring(std::uint32_t number)
+            : thread(number)
+        {
+        }
+
+        const std::uint32_t thread;
+        std::atomic<std::uint64_t> head{0};
+        std::array<Slot, TraceCapacity> slots{};
+    };
+
+    struct State
+    {
+        Ring& CreateRing()
+        {
+            std::lock_guard lock(mutex);
+            return *rings.emplace_back(std::make_unique<Ring>(static_cast<std::uint32_t>(rings.size())));
+        }
+
+        std::mutex mutex;
+        std::map<std::string, std::pair<std::size_t, std::map<std::string, std::uint16_t>>> ports;
+        std::vector<TraceName> names;
+        std::vector<std::unique_ptr<Ring>> rings; // kept after the thread exits, for post-mortem analysis
+    };
+
+    // Never destroyed, so threads can record (and dump) during static destruction
+    static State& Instance()
+    {
+        static State* state = new State();
+        return *state;
+    }
+};
+
+// Trace policy of the MultiClientSelector: record each Select() and Deselect() of a client
+struct TracedSelect
+{
+    using Point = TracePoint;
+    static Point Register(const std::string& portName, const std::string& clientName) { return EventTrace::Register(portName, clientName); }
+    static void Select(Point point) { EventTrace::Record(point, TracePhase::Select); }
+    static void Deselect(Point point) { EventTrace::Record(point, TracePhase::Deselect); }
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_EventTrace.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == 'd29db1c66b7451e5f671f836bde503ca'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_EventTrace.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
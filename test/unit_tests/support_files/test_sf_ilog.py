@@ -30,6 +30,15 @@ def template_hh(ns_prefix: str) -> str:
 // - ILog: the primer interface/struct for logging messages, with a muted default implementation.
 // - ILogWithContext: a decorator variant derived from ILog that requires an existing ILog instance,
 //                    on which it prefixes each logged message with a context string.
+// - LogLevel: the minimum level of the logged messages, set with SetLevel(). Check it with
+//             IsEnabled() or use the LazyInfo/LazyWarning/LazyError methods that only build the
+//             message when enabled. A message of a muted sink (the default) is never enabled.
+//             Note: the functors Info/Warning/Error of a plain ILog are the sinks and log regardless
+//             of the level. An ILogWithContext honours the level on all its methods. Its level in
+//             effect is the more restrictive of its own level and that of its parent ILog, which is
+//             read on each message and hence follows later changes of the parent (and its copies).
+//             ILogWithContext copies its parent ILog, so the parent may be a temporary. A sink that
+//             is muted at construction stays muted for the ILogWithContext.
 //
 // Example 1:
 //
@@ -46,6 +55,13 @@ def template_hh(ns_prefix: str) -> str:
 //     """ f'{ns_prefix}' """Dzn::ILogWithContext logger2("MyContext", logger1);
 //     logger2.Warning("See ya"); // will ultimately call MySofware.LogWarning("MyContext/See ya")
 //
+// Example 3:
+//
+//     logger1.SetLevel(""" f'{ns_prefix}' """Dzn::LogLevel::Warning); // suppress informationals
+//     """ f'{ns_prefix}' """Dzn::ILogWithContext logger3("MyContext", logger1); // follows the level of logger1
+//     logger3.LazyInfo([&] { return "Costly " + std::to_string(42); }); // message is not even built
+//     logger3.Info("Cheap"); // suppressed as well, as opposed to logger1.Info("Cheap")
+//
 //
 // This is generated code. DO NOT MODIFY manually.
 //
@@ -53,16 +69,58 @@ def template_hh(ns_prefix: str) -> str:
 // This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 
 // System includes
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace """ f'{ns_prefix}' """Dzn {
 
+// Minimum level of the messages that are logged. Messages below the level are suppressed before
+// they are built. Muted suppresses all messages; it is not meant as level of a message itself.
+enum class LogLevel
+{
+    Info,
+    Warning,
+    Error,
+    Muted
+};
+
+// The default (muted) sink of an ILog. It is recognized to not even build the messages for it.
+struct MutedSink
+{
+    void operator()(const std::string&) const {}
+};
+
+// The level of an ILog, shared with its copies. The level cell of an ILogWithContext refers to
+// the level cell of its parent log.
+struct LogLevelCell
+{
+    explicit LogLevelCell(LogLevel initial, std::shared_ptr<const LogLevelCell> parentCell = nullptr)
+        : level(initial)
+        , parent(std::move(parentCell))
+    {
+    }
+
+    // Get the level in effect: the own level, raised to the level in effect of the parent (if any)
+    LogLevel Effective() const
+    {
+        const auto own = level.load(std::memory_order_relaxed);
+        if (parent == nullptr) return own;
+        const auto inherited = parent->Effective();
+        return inherited > own ? inherited : own;
+    }
+
+    std::atomic<LogLevel> level;
+    const std::shared_ptr<const LogLevelCell> parent;
+};
+
 struct ILog
 {
-    std::function<void(const std::string& message)> Info =    {[](auto){}};
-    std::function<void(const std::string& message)> Warning = {[](auto){}};
-    std::function<void(const std::string& message)> Error =   {[](auto){}};
+    std::function<void(const std::string& message)> Info =    MutedSink{};
+    std::function<void(const std::string& message)> Warning = MutedSink{};
+    std::function<void(const std::string& message)> Error =   MutedSink{};
+    std::shared_ptr<LogLevelCell> levelCell = std::make_shared<LogLevelCell>(LogLevel::Info); // not checked by the functors above
 
     void check_bindings() const
     {
@@ -70,18 +128,40 @@ struct ILog
         if (!Warning) throw std::runtime_error("not connected: Warning()");
         if (!Error)   throw std::runtime_error("not connected: Error()");
     }
+
+    // Set the level, which takes effect for all copies of this ILog and their ILogWithContexts
+    void SetLevel(LogLevel newLevel) { levelCell->level.store(newLevel, std::memory_order_relaxed); }
+    LogLevel Level() const { return levelCell->level.load(std::memory_order_relaxed); }
+    LogLevel EffectiveLevel() const { return levelCell->Effective(); }
+
+    // A message level is enabled when it is not below the level in effect and its sink is not muted
+    bool IsEnabled(LogLevel messageLevel) const
+    {
+        if (messageLevel == LogLevel::Muted || messageLevel < EffectiveLevel()) return false;
+        return !IsMuted(messageLevel == LogLevel::Info ? Info : messageLevel == LogLevel::Warning ? Warning : Error);
+    }
+
+    static bool IsMuted(const std::function<void(const std::string&)>& sink) { return sink.target<MutedSink>() != nullptr; }
+
+    // Log a message that is built by the callable only when the respective level is enabled
+    template <typename MESSAGE_FN> void LazyInfo(MESSAGE_FN&& fn) const    { if (IsEnabled(LogLevel::Info)) Info(fn()); }
+    template <typename MESSAGE_FN> void LazyWarning(MESSAGE_FN&& fn) const { if (IsEnabled(LogLevel::Warning)) Warning(fn()); }
+    template <typename MESSAGE_FN> void LazyError(MESSAGE_FN&& fn) const   { if (IsEnabled(LogLevel::Error)) Error(fn()); }
 };
 
 struct ILogWithContext : ILog
 {
-    ILogWithContext(const std::string& contextStr, const ILog& log): ILog(), context(contextStr), subLog(log)
+    // The parent log is copied. Its level stays in effect via the shared level cell, its muted sinks stay muted.
+    ILogWithContext(const std::string& contextStr, const ILog& log): ILog(), context(contextStr), prefix(contextStr + "/"), subLog(log)
     {
-        Info    = [this](const std::string& message) { subLog.Info(context + "/" + message); };
-        Warning = [this](const std::string& message) { subLog.Warning(context + "/" + message); };
-        Error   = [this](const std::string& message) { subLog.Error(context + "/" + message); };
+        levelCell = std::make_shared<LogLevelCell>(LogLevel::Info, subLog.levelCell);
+        if (!IsMuted(subLog.Info))    Info    = [this](const std::string& message) { if (IsEnabled(LogLevel::Info)) subLog.Info(prefix + message); };
+        if (!IsMuted(subLog.Warning)) Warning = [this](const std::string& message) { if (IsEnabled(LogLevel::Warning)) subLog.Warning(prefix + message); };
+        if (!IsMuted(subLog.Error))   Error   = [this](const std::string& message) { if (IsEnabled(LogLevel::Error)) subLog.Error(prefix + message); };
     }
 
     const std::string context;
+    const std::string prefix; // precomputed once: context + "/"
     const ILog subLog;
 };
 
@@ -99,7 +179,7 @@ def test_create_default_namespaced():
     assert result.namespace == ['Dzn']
     assert result.filename == 'Dzn_ILog.hh'
     assert result.contents == DEFAULT_DZN_ILOG_HH
-    assert result.contents_hash == '9380db6b8a596563db6bfde34940019f'
+    assert result.contents_hash == '2dced3d2b77b483ea950e30ebbf75937'
     assert 'namespace Dzn {' in result.contents
 
 
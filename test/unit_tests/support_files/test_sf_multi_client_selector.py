@@ -26,8 +26,29 @@ def template_hh(cpp_ns_prefix: str, file_ns_prefix: str) -> str:
 //              implement multi client behaviour where one client at the time has access to
 //              an arbitraged/exclusive port, especially for its out events.
 //
+// The template parameter LOCK_WRAPPER selects the protection of the current selected client.
+// It defaults to MutexWrapped. Since arbitrated out-events read the selection far more often than
+// Select()/Deselect() change it, SharedMutexWrapped lets concurrent readers proceed in parallel.
+// SpinWrapped suits very short critical sections with low contention.
+//
+// Alternatively the policy AtomicSelect holds the selection as std::atomic<ClientPort*> with
+// acquire/release ordering. Reading the current client then costs a single atomic load instead
+// of a lock/unlock pair. ClientPorts are never relocated, their addresses stay stable.
+// CurrentClientPort() provides the current client as pointer (nullptr when none) for all policies.
+//
+// Each registered client gets a ClientHandle, a small index in order of registration. Select() and
+// Deselect() with a ClientHandle are O(1) without any ClientIdentifier (string) lookup or comparison.
+// The ClientIdentifier overloads remain available for compatibility.
+//
+// The template parameter TRACE selects the tracing of Select() and Deselect(). It defaults to
+// NoTrace, which costs neither a header include nor storage. TracedSelect (support file EventTrace)
+// records them in the EventTrace, where each client is registered as event of the port (named by its
+// ClientIdentifier).
+//
 // Example: Refer to Advanced Shell examples with a MultiClient port configuration.
 //
+//    """ f'{cpp_ns_prefix}' """Dzn::MultiClientSelector<IToaster, """ f'{cpp_ns_prefix}' """Dzn::SharedMutexWrapped> m_selector;
+//
 //
 // This is generated code. DO NOT MODIFY manually.
 //
@@ -35,9 +56,14 @@ def template_hh(cpp_ns_prefix: str, file_ns_prefix: str) -> str:
 // This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 
 // System includes
-#include <optional>
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Project includes
@@ -50,25 +76,49 @@ namespace """ f'{cpp_ns_prefix}' """Dzn {
 
 // Types
 using ClientIdentifier = std::string;
+using ClientHandle = std::size_t; // index of a registered client, assigned in order of registration
 
-template <typename DZN_PORT>
+// Selection policy marker: hold the current client as an atomic pointer instead of a lock wrapped value
+template <typename T>
+struct AtomicSelect
+{
+};
+
+// Trace policy: do not trace the selection of clients
+struct NoTrace
+{
+    struct Point
+    {
+    };
+    static Point Register(const std::string&, const std::string&) { return {}; }
+    static void Select(Point) {}
+    static void Deselect(Point) {}
+};
+
+template <typename DZN_PORT, template <typename> typename LOCK_WRAPPER = MutexWrapped, typename TRACE = NoTrace>
 struct MultiClientSelector final
 {
     ///////////////////////////////////////////////////////////////////////////
     // Type definitions:
     //
 
-    // Record containing the client identification and an own designated port.
+    // Record containing the client identification, its handle and an own designated port.
     struct ClientPort
     {
         ClientIdentifier identifier;
         DZN_PORT dznPort;
+        ClientHandle handle;
+        [[no_unique_address]] typename TRACE::Point tracePoint{}; // empty with NoTrace
     };
 
     // Reference to the current selected client (holding the claim). 
     // A value of std::nullopt means no client has been selected.
     using ClientSelect = std::optional<std::reference_wrapper<ClientPort>>;
 
+    // Storage of the current selected client according to the LOCK_WRAPPER policy
+    static constexpr bool IsAtomicSelect = std::is_same_v<LOCK_WRAPPER<ClientSelect>, AtomicSelect<ClientSelect>>;
+    using ClientSelectStorage = std::conditional_t<IsAtomicSelect, std::atomic<ClientPort*>, LOCK_WRAPPER<ClientSelect>>;
+
     // Function type of the callback
     using CallbackInitializePort = std::function<DZN_PORT(const ClientIdentifier&)>;
 
@@ -78,7 +128,11 @@ struct MultiClientSelector final
     //
 
     MultiClientSelector(const ILog& log, const std::string& portName, const CallbackInitializePort& cbInitializePort)
-        : m_log(portName, log)
+        : m_portName(portName)
+        , m_log(portName, log)
+        , m_logIndex("Index", m_log)
+        , m_logSelect("Select", m_log)
+        , m_logDeselect("Deselect", m_log)
         , m_cbInitializePort(cbInitializePort)
         , m_arbiteredPort(CreatePort<DZN_PORT>("arbiter" + CapitalizeFirstChar(portName), "arbitraged" + CapitalizeFirstChar(portName)))
     {
@@ -94,7 +148,7 @@ struct MultiClientSelector final
     {
         if (m_finalConstructed) throw std::runtime_error("Already final constructed.");
 
-        for (const auto& [_, client] : m_clients) client.dznPort.check_bindings();
+        for (const auto& client : m_clients) client->dznPort.check_bindings();
 
         m_log.check_bindings();
         m_finalConstructed = true;
@@ -102,29 +156,32 @@ struct MultiClientSelector final
 
     // Access a ClientPort indexed by a ClientIdentifier specification. Allocate the ClientPort if not present.
     // This method is called to register each client until the builder process concludes with FinalConstruct().
+    // The handle of the returned ClientPort can be stored for the fast Select(ClientHandle) overload.
     ClientPort& Index(const ClientIdentifier& identifier)
     {
-        ILogWithContext log("Index", m_log);
-        log.Info(identifier);
+        m_logIndex.LazyInfo([&]() -> const std::string& { return identifier; });
 
         if (identifier.empty()) throw std::runtime_error("Argument 'identifier' must not be empty.");
 
-        if (m_clients.count(identifier) == 0)
+        if (m_handles.count(identifier) == 0)
         {
-            log.Info("Allocating ClientPort entry for " + identifier);
+            m_logIndex.LazyInfo([&] { return "Allocating ClientPort entry for " + identifier; });
             if (m_finalConstructed) throw std::runtime_error("Can not allocate a ClientPort entry when final constructed.");
 
-            m_clients.insert_or_assign(identifier, ClientPort{identifier, m_cbInitializePort(identifier)});
+            const ClientHandle handle = m_clients.size();
+            m_clients.push_back(std::make_unique<ClientPort>(ClientPort{identifier, m_cbInitializePort(identifier), handle}));
+            m_clients.back()->tracePoint = TRACE::Register(m_portName, identifier);
+            m_handles.insert_or_assign(identifier, handle);
         }
 
-        return m_clients.at(identifier);
+        return *m_clients[m_handles.at(identifier)];
     }
 
     // Get a vector of all currently registered ClientIdentifiers
     auto GetClientIdentifiers() const
     {
         std::vector<ClientIdentifier> result;
-        for (auto& kv : m_clients) result.push_back(kv.first);
+        for (auto& kv : m_handles) result.push_back(kv.first);
 
         return result;
     }
@@ -136,50 +193,116 @@ struct MultiClientSelector final
 
     const DZN_PORT& Arbitered() { return m_arbiteredPort; } // grant read-only access
 
-    auto CurrentClient() { return m_clientSelect(); } // acquire 'lock-and-data' on the current ClientSelect value
+    // Acquire read 'lock-and-data' on the current ClientSelect value, or, with AtomicSelect a single atomic load
+    auto CurrentClient() const
+    {
+        if constexpr (IsAtomicSelect) return m_clientSelect.load(std::memory_order_acquire);
+        else return m_clientSelect();
+    }
+
+    // Get the current selected client as pointer (nullptr when none) regardless of the LOCK_WRAPPER policy
+    ClientPort* CurrentClientPort() const
+    {
+        if constexpr (IsAtomicSelect) return CurrentClient();
+        else
+        {
+            auto lockAndData = CurrentClient();
+            return lockAndData->has_value() ? &lockAndData->value().get() : nullptr;
+        }
+    }
 
     void Select(const ClientIdentifier& identifier)
     {
-        ILogWithContext log("Select", m_log);
-        log.Info(identifier);
+        if (m_handles.count(identifier) == 0)
+        {
+            m_logSelect.LazyInfo([&]() -> const std::string& { return identifier; });
+            return m_logSelect.LazyError([&] { return "Identifier " + identifier + " not recognised as a valid registered client."; });
+        }
 
-        if (m_clients.count(identifier) == 0) return log.Error("Identifier " + identifier + " not recognised as a valid registered client.");
+        Select(m_handles.at(identifier));
+    }
 
-        auto lockAndData = CurrentClient();
-        auto& clientSelect = *lockAndData;
-        if (clientSelect.has_value())
+    // Select a client by its handle in constant time, without any identifier lookup or comparison
+    void Select(ClientHandle handle)
+    {
+        if (handle >= m_clients.size()) return m_logSelect.LazyError([&] { return "Handle " + std::to_string(handle) + " not recognised as a valid registered client."; });
+
+        auto& client = *m_clients[handle];
+        m_logSelect.LazyInfo([&]() -> const std::string& { return client.identifier; });
+        TRACE::Select(client.tracePoint);
+
+        if constexpr (IsAtomicSelect)
         {
-            auto incompliantClient = clientSelect.value().get().identifier;
-            log.Warning("Preceeding client " + incompliantClient + " did not release the claim -> overruling it.");
+            // Switch to the new client
+            auto preceedingClient = m_clientSelect.exchange(&client, std::memory_order_acq_rel);
+            if (preceedingClient != nullptr)
+            {
+                m_logSelect.LazyWarning([&] { return "Preceeding client " + preceedingClient->identifier + " did not release the claim -> overruling it."; });
+            }
+        }
+        else
+        {
+            auto lockAndData = m_clientSelect(); // acquire write 'lock-and-data'
+            auto& clientSelect = *lockAndData;
+            if (clientSelect.has_value())
+            {
+                const auto& incompliantClient = clientSelect.value().get().identifier;
+                m_logSelect.LazyWarning([&] { return "Preceeding client " + incompliantClient + " did not release the claim -> overruling it."; });
+            }
+
+            // Switch to the new client
+            clientSelect = client;
         }
-
-        // Switch to the new client
-        clientSelect = m_clients.at(identifier);
     }
 
     void Deselect(const ClientIdentifier& identifier)
     {
-        ILogWithContext log("Deselect", m_log);
-        log.Info(identifier);
+        if (m_handles.count(identifier) == 0)
+        {
+            m_logDeselect.LazyInfo([&]() -> const std::string& { return identifier; });
+            return m_logDeselect.LazyError([&] { return "Identifier " + identifier + " does not exist."; });
+        }
+
+        Deselect(m_handles.at(identifier));
+    }
+
+    // Deselect a client by its handle in constant time, without any identifier lookup or comparison
+    void Deselect(ClientHandle handle)
+    {
+        if (handle >= m_clients.size()) return m_logDeselect.LazyError([&] { return "Handle " + std::to_string(handle) + " does not exist."; });
 
-        if (m_clients.count(identifier) == 0) return log.Error("Identifier " + identifier + " does not exist.");
+        m_logDeselect.LazyInfo([&]() -> const std::string& { return m_clients[handle]->identifier; });
+        TRACE::Deselect(m_clients[handle]->tracePoint);
 
-        auto lockAndData = CurrentClient();
-        auto& clientSelect = *lockAndData;
-        if (!clientSelect.has_value()) log.Warning("Unexpected, claim already released.");
+        if constexpr (IsAtomicSelect)
+        {
+            // Let go of the client
+            if (m_clientSelect.exchange(nullptr, std::memory_order_acq_rel) == nullptr) m_logDeselect.LazyWarning([] { return "Unexpected, claim already released."; });
+        }
+        else
+        {
+            auto lockAndData = m_clientSelect(); // acquire write 'lock-and-data'
+            auto& clientSelect = *lockAndData;
+            if (!clientSelect.has_value()) m_logDeselect.LazyWarning([] { return "Unexpected, claim already released."; });
 
-        // Let go of the client
-        clientSelect.reset();
+            // Let go of the client
+            clientSelect.reset();
+        }
     }
 
 private:
+    const std::string m_portName;
     const ILogWithContext m_log;
+    const ILogWithContext m_logIndex;    // precomputed loggers for the methods
+    const ILogWithContext m_logSelect;   // of the hot path, to avoid constructing
+    const ILogWithContext m_logDeselect; // the ILogWithContext on each call
     const std::function<DZN_PORT(const ClientIdentifier&)> m_cbInitializePort;
     DZN_PORT m_arbiteredPort;
 
     bool m_finalConstructed{false};
-    std::map<ClientIdentifier, ClientPort> m_clients;
-    MutexWrapped<ClientSelect> m_clientSelect;
+    std::vector<std::unique_ptr<ClientPort>> m_clients; // indexed by ClientHandle, each ClientPort on the heap keeps its address on growth
+    std::map<ClientIdentifier, ClientHandle> m_handles; // only used for registration and the ClientIdentifier overloads
+    ClientSelectStorage m_clientSelect{};
 };
 
 } // namespace """ f'{cpp_ns_prefix}' """Dzn
@@ -196,7 +319,7 @@ def test_create_default_namespaced():
     assert result.namespace == ['Dzn']
     assert result.filename == 'Dzn_MultiClientSelector.hh'
     assert result.contents == DEFAULT_DZN_NS_HH
-    assert result.contents_hash == 'cc3df53c673a44e881a3a61c97170c7d'
+    assert result.contents_hash == 'ae1e957b2bff3b04c69032147a26b428'
     assert 'namespace Dzn {' in result.contents
 
 
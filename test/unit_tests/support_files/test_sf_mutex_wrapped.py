@@ -27,6 +27,12 @@ def template_hh(ns_prefix: str) -> str:
 //              Releasing the lock can be done manually or automatically when the given lock goes
 //              out of scope (RAII pattern).
 //
+// Variants:
+// - MutexWrapped<T>:       exclusive std::mutex for both read (const) and write access.
+// - SharedMutexWrapped<T>: std::shared_mutex where const access takes a std::shared_lock, so
+//                          concurrent readers do not serialise. Write access stays exclusive.
+// - SpinWrapped<T>:        spin lock on a std::atomic_flag for very short critical sections.
+//
 // Tip: MutexWrap a struct containing multiple members to protect them as a whole. Considered they
 //      cohesively are 'atomic'. Instead of having separate locks that potentially can yield
 //      deadlocks when concurrent threads incrementally try to acquire them.
@@ -44,6 +50,13 @@ def template_hh(ns_prefix: str) -> str:
 //                         // let it go out of scope for automatic RAII release of the lock.
 // }
 //
+// given """ f'{ns_prefix}' """Dzn::SharedMutexWrapped<int> m_readMostlyNumber;
+//
+// {
+//    auto lockAndData = std::as_const(m_readMostlyNumber)(); // shared lock and read-only access
+//    auto number = *lockAndData;
+// }
+//
 //
 // This is generated code. DO NOT MODIFY manually.
 //
@@ -51,13 +64,38 @@ def template_hh(ns_prefix: str) -> str:
 // This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 
 // System includes
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 namespace """ f'{ns_prefix}' """Dzn {
 
-template <typename T>
-struct MutexWrapped
+// Automatic mechanism to ensure releasing the lock a la RAII
+template <typename LOCK>
+struct RaiiLockDeleter
+{
+    LOCK lock;
+
+    template <typename T>
+    void operator()(T*) { if (lock.owns_lock()) lock.unlock(); }
+};
+
+// Minimal spin lock that satisfies the Lockable requirements (usable with std::unique_lock)
+class SpinLock
+{
+public:
+    void lock() noexcept { while (m_flag.test_and_set(std::memory_order_acquire)) std::this_thread::yield(); }
+    bool try_lock() noexcept { return !m_flag.test_and_set(std::memory_order_acquire); }
+    void unlock() noexcept { m_flag.clear(std::memory_order_release); }
+
+private:
+    std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+};
+
+template <typename T, typename MUTEX, typename READ_LOCK, typename WRITE_LOCK>
+struct LockWrapped
 {
     // Get access to the protected data. May have to wait on a concurrent claiming thread to unlock
     // it first. When lock has been acquired, the client is given a unique_ptr to the data.
@@ -67,21 +105,31 @@ struct MutexWrapped
     // - implicitly and guaranteed when the unique_ptr goes out of scope (calls RaiiLockDeleter)
     auto operator()( )
     {
-        std::unique_lock lock(m_mutex);
-        return std::unique_ptr<T, RaiiLockDeleter>(&m_protectee, RaiiLockDeleter{std::move(lock)});
+        WRITE_LOCK lock(m_mutex);
+        return std::unique_ptr<T, RaiiLockDeleter<WRITE_LOCK>>(&m_protectee, RaiiLockDeleter<WRITE_LOCK>{std::move(lock)});
     }
 
-private:
-    T m_protectee;      // default construct typename T
-    std::mutex m_mutex; // the mutex coupled to the protectee
-
-    struct RaiiLockDeleter // automatic mechanism to ensure releasing the lock a la RAII
+    // Get read-only access to the protected data. Same as above but with the (possibly shared) read lock.
+    auto operator()( ) const
     {
-        std::unique_lock<std::mutex> lock;
-        void operator()(T*) { if (lock.owns_lock()) lock.unlock(); }
-    };
+        READ_LOCK lock(m_mutex);
+        return std::unique_ptr<const T, RaiiLockDeleter<READ_LOCK>>(&m_protectee, RaiiLockDeleter<READ_LOCK>{std::move(lock)});
+    }
+
+private:
+    T m_protectee;         // default construct typename T
+    mutable MUTEX m_mutex; // the mutex coupled to the protectee
 };
 
+template <typename T>
+using MutexWrapped = LockWrapped<T, std::mutex, std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>;
+
+template <typename T>
+using SharedMutexWrapped = LockWrapped<T, std::shared_mutex, std::shared_lock<std::shared_mutex>, std::unique_lock<std::shared_mutex>>;
+
+template <typename T>
+using SpinWrapped = LockWrapped<T, SpinLock, std::unique_lock<SpinLock>, std::unique_lock<SpinLock>>;
+
 } // namespace """ f'{ns_prefix}' """Dzn
 // Generated by: dznpy/support_files v"""f'{VERSION}'"""
 """
@@ -96,7 +144,7 @@ def test_create_default_namespaced():
     assert result.namespace == ['Dzn']
     assert result.filename == 'Dzn_MutexWrapped.hh'
     assert result.contents == DEFAULT_DZN_NS_HH
-    assert result.contents_hash == '9212c72dd96ab761359921e43df44ba2'
+    assert result.contents_hash == '9550b27a1f7fa9063fd54842dfcccca2'
     assert 'namespace Dzn {' in result.contents
 
 
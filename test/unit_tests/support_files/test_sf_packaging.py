@@ -0,0 +1,158 @@
+"""
+Testsuite validating the output of generated support file packagings: Umbrella header and Module.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.code_gen_common import GeneratedContent
+from dznpy.misc_utils import namespaceids_t
+from dznpy.support_files import ilog, multi_client_selector, strict_port
+
+# systems-under-test
+from dznpy.support_files import packaging as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+FILES = [GeneratedContent('Dzn_A.hh', '// A\n#include <string>\n#include <dzn/meta.hh>\n'),
+         GeneratedContent('Dzn_B.hh', '// B\n#include <map>\n#include <string>\n'
+                                      '#include "Dzn_A.hh"\n'),
+         GeneratedContent('Dzn_C.hh', '// C\n#include <atomic>\n'),
+         GeneratedContent('Dzn_Awaitable.hh', '// D\n#include <coroutine>\n')]
+
+
+def template_umbrella_hh(ns_prefix: str) -> str:
+    return """\
+// Support Files (umbrella header)
+//
+// Description: aggregation of all support files in a single header that is suitable to be
+//              precompiled, so a translation unit does not parse the support files itself.
+//
+// Usage: include this header instead of the individual support files, e.g. configure it as the
+//        precompiled header of the target. The support files are in namespace """ f'{ns_prefix}' """Dzn.
+//        Support files that require C++20 (e.g. the coroutines of Awaitable) are only included when
+//        the compiler provides the respective feature.
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+#pragma once
+
+// Project includes
+#include "Dzn_B.hh"
+#include "Dzn_C.hh"
+#if __cpp_impl_coroutine
+#include "Dzn_Awaitable.hh"
+#endif
+
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+def template_module_cppm(module_name: str) -> str:
+    return """\
+// Support Files (C++20 module interface unit)
+//
+// Description: module """ f'{module_name}' """ that exports all support files, so a translation unit
+//              imports them instead of parsing the support files itself.
+//
+// Usage: compile this module interface unit as part of the target, and import the module instead of
+//        including the individual support files:
+//
+//    import """ f'{module_name}' """;
+//
+// Note: the system includes (e.g. the Dezyne runtime headers) are in the global module fragment,
+//       hence they are not exported. Include them where used.
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+module;
+
+// System includes
+#include <atomic>
+#include <coroutine>
+#include <dzn/meta.hh>
+#include <map>
+#include <string>
+
+export module """ f'{module_name}' """;
+
+export {
+#include "Dzn_B.hh"
+#include "Dzn_C.hh"
+#include "Dzn_Awaitable.hh"
+}
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+def test_root_files():
+    assert sut.root_files(FILES) == [FILES[1], FILES[2], FILES[3]]
+    assert sut.root_files([]) == []
+
+
+def test_root_files_of_support_files():
+    files = [strict_port.create_header(), ilog.create_header(), multi_client_selector.create_header()]
+    assert sut.root_files(files) == [files[0], files[2]]
+
+
+def test_system_includes():
+    assert sut.system_includes(FILES) == ['atomic', 'coroutine', 'dzn/meta.hh', 'map', 'string']
+
+
+def test_feature_guard():
+    assert [sut.feature_guard(x) for x in FILES] == [None, None, None, '__cpp_impl_coroutine']
+
+
+def test_module_name():
+    assert sut.module_name(['Dzn']) == 'Dzn.SupportFiles'
+    assert sut.module_name(['Proj', 'Dzn']) == 'Proj.Dzn.SupportFiles'
+
+
+def test_create_umbrella_header_default_namespaced():
+    result = sut.create_umbrella_header(FILES)
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_SupportFiles.hh'
+    assert result.contents == template_umbrella_hh('')
+
+
+def test_create_umbrella_header_with_prefixing_namespace():
+    result = sut.create_umbrella_header(FILES, namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_SupportFiles.hh'
+    assert result.contents == template_umbrella_hh('Proj::')
+
+
+def test_create_module_interface_default_namespaced():
+    result = sut.create_module_interface(FILES)
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_SupportFiles.cppm'
+    assert result.contents == template_module_cppm('Dzn.SupportFiles')
+
+
+def test_create_module_interface_with_prefixing_namespace():
+    result = sut.create_module_interface(FILES, namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_SupportFiles.cppm'
+    assert result.contents == template_module_cppm('Proj.Dzn.SupportFiles')
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_umbrella_header(FILES, 123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
+    with pytest.raises(TypeError) as exc:
+        sut.create_module_interface(FILES, 123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
@@ -0,0 +1,186 @@
+"""
+Testsuite validating the output of generated support file: Priority Lanes.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import priority_lanes as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Priority Lanes
+//
+// Description: a front-end of a dispatcher (like dzn::pump) with a priority lane and a normal lane
+//              of jobs. A single drain job at the dispatcher executes one job, where it always takes
+//              the next job from the priority lane first, and re-posts itself while jobs remain.
+//              Within a lane the jobs keep their FIFO order. Hence a flood of normal jobs delays a
+//              priority job by at most the one normal job that is being executed, and the lanes do
+//              not starve the other jobs of the dispatcher.
+//
+// Usage: every job must be posted via the Priority Lanes, because jobs posted to the dispatcher
+//        directly are queued behind the pending drain job.
+//
+// Example:
+//
+//    """ f'{ns_prefix}' """Dzn::PriorityLanes<dzn::pump> lanes(myPump);
+//
+//    lanes([&] { myComp.hal.out.Sample(1); });          // normal lane
+//    lanes.Priority([&] { myComp.hal.out.Overheat(); }); // executed before Sample(1) when still pending
+//    lanes.PriorityShell([&] { myComp.api.in.Stop(); }); // blocking, like dzn::shell
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+template <typename DISPATCHER>
+class PriorityLanes
+{
+public:
+    using Job = std::function<void()>;
+
+    explicit PriorityLanes(DISPATCHER& dispatcher)
+        : m_dispatcher(dispatcher)
+    {
+    }
+
+    PriorityLanes(const PriorityLanes&) = delete;
+    PriorityLanes& operator=(const PriorityLanes&) = delete;
+
+    // Post a job to the normal lane
+    void operator()(Job job) { Post(m_lanes->normal, std::move(job)); }
+
+    // Post a job to the priority lane
+    void Priority(Job job) { Post(m_lanes->priority, std::move(job)); }
+
+    // Post a job to the normal lane and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto Shell(CALLABLE&& callable) -> decltype(callable())
+    {
+        return Await(m_lanes->normal, callable);
+    }
+
+    // Post a job to the priority lane and block the caller until it has been executed
+    template <typename CALLABLE>
+    auto PriorityShell(CALLABLE&& callable) -> decltype(callable())
+    {
+        return Await(m_lanes->priority, callable);
+    }
+
+private:
+    using Lane = std::deque<Job>;
+
+    // The lanes, shared with the pending drain job
+    struct Lanes
+    {
+        // Executed on the dispatcher thread, executes the next job. Replies true when jobs remain,
+        // the drain job must then be re-posted (drainPosted is still set).
+        bool Drain()
+        {
+            Job job;
+            {
+                std::lock_guard lock(mutex);
+                Lane& lane = priority.empty() ? normal : priority;
+                job = std::move(lane.front());
+                lane.pop_front();
+            }
+            job();
+
+            std::lock_guard lock(mutex);
+            if (!priority.empty() || !normal.empty()) return true;
+            drainPosted = false;
+            return false;
+        }
+
+        std::mutex mutex;
+        Lane priority;
+        Lane normal;
+        bool drainPosted{false};
+    };
+
+    void Post(Lane& lane, Job job)
+    {
+        std::lock_guard lock(m_lanes->mutex);
+        lane.push_back(std::move(job));
+        if (m_lanes->drainPosted) return;
+        m_lanes->drainPosted = true;
+        PostDrain(m_dispatcher, m_lanes);
+    }
+
+    // Post a drain job that co-owns the lanes, it re-posts itself while jobs remain
+    static void PostDrain(DISPATCHER& dispatcher, const std::shared_ptr<Lanes>& lanes)
+    {
+        dispatcher([&dispatcher, lanes] {
+            if (lanes->Drain()) PostDrain(dispatcher, lanes);
+        });
+    }
+
+    template <typename CALLABLE>
+    auto Await(Lane& lane, CALLABLE& callable) -> decltype(callable())
+    {
+        using RESULT = decltype(callable());
+        std::promise<RESULT> promise;
+        Post(lane, [&] {
+            if constexpr (std::is_void_v<RESULT>) { callable(); promise.set_value(); }
+            else promise.set_value(callable());
+        });
+        return promise.get_future().get();
+    }
+
+    DISPATCHER& m_dispatcher;
+    std::shared_ptr<Lanes> m_lanes{std::make_shared<Lanes>()};
+};
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_PriorityLanes.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == '4da88a4bd0be3206f1a58aa947e2cd91'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_PriorityLanes.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
@@ -0,0 +1,103 @@
+"""
+Testsuite validating the output of generated support file: Reroute Helpers.
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import pytest
+
+# dznpy modules
+from dznpy.misc_utils import namespaceids_t
+
+# systems-under-test
+from dznpy.support_files import reroute_helpers as sut
+
+# Test data
+from dznpy.dznpy_version import VERSION
+
+
+def template_hh(ns_prefix: str) -> str:
+    return """\
+// Reroute Helpers
+//
+// Description: helpers to reroute an event of a port via a dispatcher (like dzn::pump) to the
+//              respective event of an other port, instead of an open-coded lambda per event. The
+//              helpers are instantiated per dispatcher type and event signature, hence all events
+//              with an equal signature share the same code.
+//
+// - RerouteShell: the caller is blocked until the dispatcher has handled the event (dzn::shell),
+//                 the arguments are passed by reference.
+// - ReroutePost:  the event is posted to the dispatcher (fire-and-forget), the arguments are moved
+//                 into the posted job. The event must have a void return type and solely in-formals.
+//
+// Both helpers refer to the target event (std::function) and the dispatcher, which must outlive the
+// rerouted event.
+//
+// Example:
+//
+//    myShellPort.in.Start = """ f'{ns_prefix}' """Dzn::RerouteShell(myPump, myComp.api.in.Start);
+//    myShellPort.out.Sample = """ f'{ns_prefix}' """Dzn::ReroutePost(myPump, myComp.hal.out.Sample);
+//
+//
+// This is generated code. DO NOT MODIFY manually.
+//
+// Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+// This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+
+// System includes
+#include <dzn/pump.hh>
+#include <tuple>
+#include <utility>
+
+namespace """ f'{ns_prefix}' """Dzn {
+
+template <typename DISPATCHER, typename TARGET>
+auto RerouteShell(DISPATCHER& dispatcher, TARGET& target)
+{
+    return [&dispatcher, &target](auto&&... args) {
+        return dzn::shell(dispatcher, [&] { return target(std::forward<decltype(args)>(args)...); });
+    };
+}
+
+template <typename DISPATCHER, typename TARGET>
+auto ReroutePost(DISPATCHER& dispatcher, TARGET& target)
+{
+    return [&dispatcher, &target](auto... args) {
+        dispatcher([&target, arguments = std::make_tuple(std::move(args)...)]() mutable {
+            std::apply(target, std::move(arguments));
+        });
+    };
+}
+
+} // namespace """ f'{ns_prefix}' """Dzn
+// Generated by: dznpy/support_files v"""f'{VERSION}'"""
+"""
+
+
+DEFAULT_DZN_NS_HH = template_hh('')
+PROJ_DZN_NS_HH = template_hh('Proj::')
+
+
+def test_create_default_namespaced():
+    result = sut.create_header()
+    assert result.namespace == ['Dzn']
+    assert result.filename == 'Dzn_RerouteHelpers.hh'
+    assert result.contents == DEFAULT_DZN_NS_HH
+    assert result.contents_hash == '43ceb445eef87726e3edf76c4a87c1f8'
+    assert 'namespace Dzn {' in result.contents
+
+
+def test_create_with_prefixing_namespace():
+    result = sut.create_header(namespaceids_t('Proj'))
+    assert result.namespace == ['Proj', 'Dzn']
+    assert result.filename == 'Proj_Dzn_RerouteHelpers.hh'
+    assert result.contents == PROJ_DZN_NS_HH
+    assert 'namespace Proj::Dzn {' in result.contents
+
+
+def test_create_fail():
+    with pytest.raises(TypeError) as exc:
+        sut.create_header(123)
+    assert str(exc.value) == 'namespace_prefix is of incorrect type'
@@ -0,0 +1,69 @@
+"""
+Testsuite validating the ast_cache module
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import os
+import tempfile
+from unittest.mock import patch
+
+# dznpy modules
+from dznpy.json_ast import DznJsonAst
+
+# system-under-test
+from dznpy import ast_cache
+from dznpy.ast_cache import AstCache
+
+# test helpers
+from common.helpers import resolve
+from testdata_json_ast import TOASTER_SYSTEM_JSON_FILE
+
+# test constants
+DZNJSON_FILE = resolve(__file__, TOASTER_SYSTEM_JSON_FILE)
+
+
+def test_cache_key():
+    """Test the cache key depends on both the JSON contents and the dznpy version."""
+    key = AstCache.cache_key(b'{}')
+    assert len(key) == 32
+    assert key == AstCache.cache_key(b'{}')
+    assert key != AstCache.cache_key(b'[]')
+    with patch.object(ast_cache, 'VERSION', '0.0.0'):
+        assert key != AstCache.cache_key(b'{}')
+
+
+def test_load_file_miss_then_hit():
+    """Test the first load parses and stores the FileContents and the next load (by another cache
+    instance) is served from the cache with equal contents."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        cache_dir = os.path.join(tmp_dir, 'cache')
+        first = AstCache(cache_dir)
+        fc = first.load_file(DZNJSON_FILE)
+        assert (first.hits, first.misses) == (0, 1)
+        assert len(os.listdir(cache_dir)) == 1
+
+        second = AstCache(cache_dir)
+        with patch.object(ast_cache, 'DznJsonAst', side_effect=AssertionError('parsed')):
+            cached_fc = second.load_file(DZNJSON_FILE)
+        assert (second.hits, second.misses) == (1, 0)
+        assert repr(cached_fc) == repr(fc)
+        assert repr(cached_fc) == repr(DznJsonAst().load_file(DZNJSON_FILE).process())
+
+
+def test_load_file_corrupt_entry():
+    """Test a corrupt cache entry is a miss that is overwritten by a new entry."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        sut = AstCache(tmp_dir)
+        with open(DZNJSON_FILE, 'rb') as file:
+            filepath = sut.cache_filepath(AstCache.cache_key(file.read()))
+        with open(filepath, 'wb') as file:
+            file.write(b'not a pickle')
+
+        assert sut.load_file(DZNJSON_FILE).systems
+        assert (sut.hits, sut.misses) == (0, 1)
+        assert sut.load_file(DZNJSON_FILE).systems
+        assert (sut.hits, sut.misses) == (1, 1)
+        assert os.listdir(tmp_dir) == [os.path.basename(filepath)]
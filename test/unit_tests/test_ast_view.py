@@ -88,6 +88,54 @@ class FindItemsInFileContentsTest(DznAstViewTestCase):
         assert result[0].fqn == ['My', 'ToasterSystem']
 
 
+class SymbolIndexTest(DznAstViewTestCase):
+
+    def test_index_built_once(self):
+        index = self.fc.symbol_index
+        assert self.fc.symbol_index is index
+        assert find_on_fqn(self.fc, ['ToasterSystem'], ['My']) is index.on_fqn[-1][('My', 'ToasterSystem')]
+
+    def test_index_rebuilt_on_mutation(self):
+        index = self.fc.symbol_index
+        assert find(self.fc, 'ExtraExtern') == []
+        extern = ast.Extern(fqn=['My', 'ExtraExtern'], parent_ns=None,
+                            name=ast.ScopeName(['ExtraExtern']), value=ast.Data('int'))
+        self.fc.externs.append(extern)
+        assert find(self.fc, 'ExtraExtern') == [extern]
+        assert find_on_fqn(self.fc, ['ExtraExtern'], ['My']) is extern
+        assert self.fc.symbol_index is not index
+
+    def test_index_rebuilt_on_replacement(self):
+        index = self.fc.symbol_index
+        sizes = [len(self.fc.externs), len(self.fc.interfaces)]
+        replaced = self.fc.externs[0]
+        extern = ast.Extern(fqn=['My', 'ReplacedExtern'], parent_ns=None,
+                            name=ast.ScopeName(['ReplacedExtern']), value=ast.Data('int'))
+
+        self.fc.externs[0] = extern
+        assert [len(self.fc.externs), len(self.fc.interfaces)] == sizes
+        assert self.fc.symbol_index is not index
+        assert find(self.fc, 'ReplacedExtern') == [extern]
+        assert find_on_fqn(self.fc, ['ReplacedExtern'], ['My']) is extern
+        assert replaced not in find(self.fc, replaced.fqn[-1])
+
+        # moving an element between containers without changing the total number of elements
+        index = self.fc.symbol_index
+        interface = self.fc.interfaces.pop()
+        self.fc.externs.remove(extern)
+        self.fc.interfaces.append(interface)
+        self.fc.externs.append(replaced)
+        assert self.fc.symbol_index is not index
+        assert find(self.fc, 'ReplacedExtern') == []
+
+    def test_container_precedence_over_scope(self):
+        inner_extern = ast.Extern(fqn=['My', 'Toaster'], parent_ns=None,
+                                  name=ast.ScopeName(['Toaster']), value=ast.Data('int'))
+        self.fc.externs.append(inner_extern)
+        assert isinstance(find_on_fqn(self.fc, ['Toaster'], ['My', 'Sub']), ast.Component)
+        assert find(self.fc, 'Toaster')[-1] is inner_extern
+
+
 class GetPortNamesTest(DznAstViewTestCase):
 
     def test_ok(self):
@@ -95,3 +143,66 @@ class GetPortNamesTest(DznAstViewTestCase):
         assert isinstance(result, ast_view.PortNames)
         assert result.provides == {'api'}
         assert result.requires == {'heater'}
+
+
+class FindDependenciesTest(DznAstViewTestCase):
+
+    def test_ok(self):
+        result = ast_view.find_dependencies(self.fc, self.example_system)
+        assert isinstance(result, ast_view.Dependencies)
+        assert result.encapsulee is self.example_system
+        assert [x.fqn for x in result.interfaces] == [['IToaster'], ['My', 'IHeaterElement']]
+        # resolved as of the scope of the interface, each type once and unresolved ones skipped
+        assert [x.fqn for x in result.types] == [['My', 'IHeaterElement', 'Result'],
+                                                 ['My', 'MilliSeconds']]
+        assert result.elements == [self.example_system] + result.interfaces + result.types
+
+    def test_without_ports(self):
+        component = ast.Component(['Lonely'], self.example_system.parent_ns,
+                                  ast.ScopeName(['Lonely']), ast.Ports())
+        result = ast_view.find_dependencies(self.fc, component)
+        assert result.interfaces == []
+        assert result.types == []
+
+
+class FindShardsTest(DznAstViewTestCase):
+
+    @staticmethod
+    def create_system(instance_names: list, bindings: list) -> ast.System:
+        def endpoint(text: str) -> ast.EndPoint:
+            instance_name, _, port_name = text.rpartition('.')
+            return ast.EndPoint(port_name, instance_name or None)
+
+        return ast.System(['Sys'], None, ast.ScopeName(['Sys']), ast.Ports(),
+                          ast.Instances([ast.Instance(x, ast.ScopeName(['Comp'])) for x in
+                                         instance_names]),
+                          ast.Bindings([ast.Binding(endpoint(left), endpoint(right)) for
+                                        left, right in bindings]))
+
+    def test_example_system(self):
+        result = ast_view.find_shards(self.example_system)
+        # the unbound instance timer1 forms a shard of its own
+        assert [[x.name for x in shard.instances] for shard in result] == [['mytoaster'],
+                                                                           ['timer1']]
+        assert result[0].bindings == []
+        assert result[0].boundary == {'api': ast.EndPoint('myport', 'mytoaster')}
+        assert result[1].boundary == {}
+
+    def test_transitive_and_declaration_order(self):
+        system = self.create_system(['a', 'b', 'c', 'd', 'e'],
+                                    [('api1', 'a.api'), ('d.hw', 'api2'), ('c.dep', 'e.api'),
+                                     ('a.dep', 'c.api'), ('b.api', 'api3')])
+        result = ast_view.find_shards(system)
+        assert [[x.name for x in shard.instances] for shard in result] == [['a', 'c', 'e'], ['b'],
+                                                                           ['d']]
+        assert [len(shard.bindings) for shard in result] == [2, 0, 0]
+        assert result[0].bindings[0].left == ast.EndPoint('dep', 'c')
+        assert result[0].boundary == {'api1': ast.EndPoint('api', 'a')}
+        assert result[1].boundary == {'api3': ast.EndPoint('api', 'b')}
+        assert result[2].boundary == {'api2': ast.EndPoint('hw', 'd')}
+
+    def test_unknown_instance(self):
+        system = self.create_system(['a'], [('a.dep', 'x.api')])
+        with pytest.raises(ValueError) as exc:
+            ast_view.find_shards(system)
+        assert str(exc.value) == 'Binding refers to unknown instance "x"'
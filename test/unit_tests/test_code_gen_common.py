@@ -5,11 +5,15 @@ Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
 This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
+# system modules
+import os
+import tempfile
+
 # dznpy modules
 from dznpy.misc_utils import namespaceids_t
 
 # system-under-test
-from dznpy.code_gen_common import GeneratedContent
+from dznpy.code_gen_common import CodeGenResult, GeneratedContent
 
 
 def test_generated_content():
@@ -27,3 +31,32 @@ def test_generated_content_with_ns():
     part in the dataclass as member."""
     sut = GeneratedContent('filename.txt', 'Hi There\n', namespace=namespaceids_t('My.Project'))
     assert sut.namespace == ['My', 'Project']
+
+
+def test_write_if_changed():
+    """Test a file is only written when it is missing or its contents differ. Expect an unchanged
+    file to keep its timestamp."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        output_dir = os.path.join(tmp_dir, 'output')
+        filepath = os.path.join(output_dir, 'filename.txt')
+        assert GeneratedContent('filename.txt', 'Hi There\n').write_if_changed(output_dir)
+        with open(filepath, 'rb') as file:
+            assert file.read() == b'Hi There\n'
+
+        os.utime(filepath, (0, 0))
+        assert not GeneratedContent('filename.txt', 'Hi There\n').write_if_changed(output_dir)
+        assert os.path.getmtime(filepath) == 0
+
+        assert GeneratedContent('filename.txt', 'Bye\n').write_if_changed(output_dir)
+        assert os.path.getmtime(filepath) != 0
+        assert os.listdir(output_dir) == ['filename.txt']
+
+
+def test_code_gen_result_write_if_changed():
+    """Test only the changed files of a result are written and replied."""
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        first = CodeGenResult([GeneratedContent('a.hh', 'A\n'), GeneratedContent('b.hh', 'B\n')])
+        assert first.write_if_changed(tmp_dir) == first.files
+        second = CodeGenResult([GeneratedContent('a.hh', 'A\n'), GeneratedContent('b.hh', 'C\n')])
+        assert second.write_if_changed(tmp_dir) == [second.files[1]]
+        assert first.write_if_changed(tmp_dir) == [first.files[1]]
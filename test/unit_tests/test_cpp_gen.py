@@ -240,6 +240,15 @@ def test_explicit_constructor_ok():
     assert sut.as_def == CONSTRUCTOR_PARAMS_DEF
 
 
+def test_inline_constructor_ok():
+    param1 = param_t(['int'], 'x')
+    param2 = param_t(['size_t'], 'y', '123u')
+    sut = Constructor(scope=Class('MyToaster'), explicit=True, params=[param1, param2],
+                      contents=CONTENTS_MULTI_LINE, inline=True)
+    assert sut.as_decl == CONSTRUCTOR_EXPLICIT_DECL
+    assert sut.as_def == f'inline {CONSTRUCTOR_PARAMS_DEF}'
+
+
 def test_constructor_with_default_initialization():
     sut = Constructor(scope=Class('MyToaster'), initialization='default')
     assert sut.as_decl == CONSTRUCTOR_INITIALIZATION_DEFAULT_DECL
@@ -405,6 +414,14 @@ def test_member_function_override():
     assert sut.as_def == MEMBER_FUNCTION_OVERRIDE_DEF
 
 
+def test_inline_member_function():
+    sut = Function(return_type=void_t(), name='Calc', override=True,
+                   contents=CONTENTS_MULTI_LINE,
+                   scope=Class('MyClass'), inline=True)
+    assert sut.as_decl == MEMBER_FUNCTION_OVERRIDE_DECL
+    assert sut.as_def == f'inline {MEMBER_FUNCTION_OVERRIDE_DEF}'
+
+
 def test_member_variable():
     assert str(MemberVariable(type=float_t(), name='MyNumber')) == 'float MyNumber;'
     assert str(
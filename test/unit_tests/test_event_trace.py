@@ -0,0 +1,87 @@
+"""
+Testsuite validating the event_trace module
+
+Copyright (c) 2023-2024 Michael van de Ven <michael@ftr-ict.com>
+This is free software, released under the MIT License. Refer to dznpy/LICENSE.
+"""
+
+# system modules
+import struct
+import pytest
+
+# system-under-test
+from dznpy.event_trace import *
+
+
+def pack_string(value: str) -> bytes:
+    return struct.pack('<H', len(value)) + value.encode()
+
+
+def pack_trace(names, records, version: int = 1) -> bytes:
+    data = b'DZNTRACE' + struct.pack('<II', version, len(names))
+    for port, event, port_name, event_name in names:
+        data += struct.pack('<HH', port, event) + pack_string(port_name) + pack_string(event_name)
+    data += struct.pack('<I', len(records))
+    for timestamp, thread, port, event, phase in records:
+        data += struct.pack('<QIHHB7x', timestamp, thread, port, event, phase)
+    return data
+
+
+NAMES = [(0, 0, 'MyShell.api', 'Start'), (0, 1, 'MyShell.api', 'Stop'),
+         (1, 0, 'MyShell.hal', 'Sample')]
+RECORDS = [(1000, 0, 0, 0, 0), (1500, 1, 0, 0, 1), (4000, 0, 1, 0, 0), (4250, 2, 5, 7, 2)]
+
+
+def test_decode():
+    result = decode(pack_trace(NAMES, RECORDS))
+    assert result.names == [TraceName(*x) for x in NAMES]
+    assert result.records[0] == TraceRecord(1000, 0, 0, 0, TracePhase.ENQUEUE)
+    assert result.records[1] == TraceRecord(1500, 1, 0, 0, TracePhase.DEQUEUE)
+    assert result.records[3] == TraceRecord(4250, 2, 5, 7, TracePhase.SELECT)
+    assert len(pack_trace([], RECORDS[:1])) - len(pack_trace([], [])) == RECORD_SIZE
+
+
+def test_decode_empty():
+    result = decode(pack_trace([], []))
+    assert result.names == []
+    assert result.records == []
+    assert str(result) == ''
+
+
+def test_name_of():
+    result = decode(pack_trace(NAMES, RECORDS))
+    assert result.name_of(result.records[0]) == 'MyShell.api.Start'
+    assert result.name_of(result.records[2]) == 'MyShell.hal.Sample'
+    assert result.name_of(result.records[3]) == '<port 5>.<event 7>'
+
+
+def test_name_of_constructed():
+    names = [TraceName(*x) for x in NAMES]
+    result = EventTrace(names, [TraceRecord(0, 0, 1, 0, TracePhase.SELECT)])
+    assert result.name_of(result.records[0]) == 'MyShell.hal.Sample'
+    assert result == EventTrace(names, result.records)
+    assert 'lookup' not in repr(result)
+
+
+def test_str():
+    result = decode(pack_trace(NAMES, RECORDS[:2]))
+    assert str(result) == '       0.000 us  thread 0   ENQUEUE  MyShell.api.Start\n' \
+                          '       0.500 us  thread 1   DEQUEUE  MyShell.api.Start'
+
+
+def test_decode_fail():
+    with pytest.raises(ValueError) as exc:
+        decode(b'NOTTRACE' + bytes(16))
+    assert str(exc.value) == 'Not an event trace'
+
+    with pytest.raises(ValueError) as exc:
+        decode(pack_trace(NAMES, RECORDS, version=2))
+    assert str(exc.value) == 'Unsupported event trace version 2'
+
+    with pytest.raises(ValueError) as exc:
+        decode(pack_trace(NAMES, RECORDS)[:-1])
+    assert str(exc.value) == 'Event trace truncated at offset 164'
+
+    with pytest.raises(ValueError) as exc:
+        decode(b'')
+    assert str(exc.value) == 'Event trace truncated at offset 0'
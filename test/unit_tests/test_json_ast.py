@@ -6,8 +6,11 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
 # system modules
+import os
+import tempfile
 from unittest import TestCase
 import pytest
+import orjson
 from orjson import JSONDecodeError
 from typing import List
 
@@ -754,6 +757,19 @@ class ScopeNameTest(DznTestCase):
             json_ast.parse_scope_name(dzn.ast)
         assert str(exc.value) == 'parse_scope_name: list "ids" is empty'
 
+    @staticmethod
+    def test_fail_other_type():
+        dzn = DznJsonAst(json_contents=SCOPE_NAME_FAIL_OTHER_TYPE)
+        with pytest.raises(DznJsonError) as exc:
+            json_ast.parse_scope_name(dzn.ast)
+        assert str(exc.value) == 'parse_scope_name: list "ids" contains other types than "str"'
+
+    @staticmethod
+    def test_interned_ids():
+        first = json_ast.parse_scope_name(DznJsonAst(json_contents=SCOPE_NAME_EX).ast)
+        second = json_ast.parse_scope_name(DznJsonAst(json_contents=SCOPE_NAME_EX).ast)
+        assert all(x is y for x, y in zip(first.value, second.value))
+
 
 class SignatureTest(DznTestCase):
 
@@ -917,6 +933,149 @@ class LoadFileTest(DznTestCase):
         assert_items_name_on_fqn(fc.systems, expected_system_fqns)
 
 
+class LoadFileLazyTest(DznTestCase):
+
+    @staticmethod
+    def test_open_dezyne_json_ok():
+        sut = DznJsonAst().load_file(DZNJSON_FILE, lazy=True)
+        assert sut.is_lazy
+        assert sut.ast is None
+
+    @staticmethod
+    def test_not_dezyne_json():
+        sut = DznJsonAst(verbose=True).load_file(SOME_JSON_FILE, lazy=True)
+        with pytest.raises(DznJsonError) as exc:
+            sut.process()
+        assert str(exc.value) == 'parse_root: missing "<class>" key'
+
+    @staticmethod
+    def test_process_equals_eager():
+        eager = DznJsonAst().load_file(DZNJSON_FILE).process()
+        lazy = DznJsonAst().load_file(DZNJSON_FILE, lazy=True).process()
+        for name in ['components', 'enums', 'externs', 'foreigns', 'interfaces', 'subints',
+                     'systems']:
+            assert_items_name_on_fqn(getattr(lazy, name),
+                                     ['.'.join(x.fqn) for x in getattr(eager, name)])
+        assert lazy.filenames == eager.filenames
+        assert lazy.imports == eager.imports
+
+    @staticmethod
+    def test_process_reachable():
+        sut = DznJsonAst().load_file(DZNJSON_FILE, lazy=True)
+        fc = sut.process_reachable(['My', 'Project', 'ToasterSystem'])
+        assert_items_name_on_fqn(fc.systems, ['My.Project.ToasterSystem'])
+        assert_items_name_on_fqn(fc.interfaces, ['My.Project.IToaster', 'Some.Vendor.IHeaterElement',
+                                                 'My.ILed', 'My.Project.Hal.IPowerCord'])
+        # the components of the instances of the system
+        assert_items_name_on_fqn(fc.components, ['My.Project.Toaster'])
+        assert_items_name_on_fqn(fc.foreigns, ['Facilities.Timer'])
+        assert len(sut.lazy_index['interface']) == 6  # located, but only 4 materialized
+
+    @staticmethod
+    def test_located_span_of_nested_element():
+        sut = DznJsonAst().load_file(DZNJSON_FILE, lazy=True)
+        lazy_element = sut.lazy_index['system'][('My', 'Project', 'ToasterSystem')]
+        assert lazy_element.parent_ns.fqn == ['My', 'Project']
+        # the span of each element itself instead of that of its top-level namespace
+        with open(DZNJSON_FILE, 'rb') as file:
+            contents = file.read()
+        for cls, lazy_elements in sut.lazy_index.items():
+            for fqn, lazy_element in lazy_elements.items():
+                element = orjson.loads(contents[lazy_element.span[0]:lazy_element.span[1]])
+                assert element['<class>'] == cls
+                assert element['name']['ids'][-1] == fqn[-1]
+
+    @staticmethod
+    def test_locate_namespace_in_any_key_order():
+        elements = [{'<class>': 'extern', 'name': {'<class>': 'scope_name', 'ids': ['Inner']},
+                     'value': {'<class>': 'data', 'value': 'int'}}]
+        namespaces = [{'<class>': 'namespace', 'name': {'<class>': 'scope_name', 'ids': ['A']},
+                       'elements': elements},
+                      {'elements': elements, 'name': {'<class>': 'scope_name', 'ids': ['B']},
+                       '<class>': 'namespace'}]
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            filepath = os.path.join(tmp_dir, 'namespaces.json')
+            with open(filepath, 'wb') as file:
+                file.write(orjson.dumps({'<class>': 'root', 'elements': namespaces}))
+            fc = DznJsonAst().load_file(filepath, lazy=True).process()
+        assert_items_name_on_fqn(fc.externs, ['A.Inner', 'B.Inner'])
+
+    @staticmethod
+    def test_process_reachable_equals_eager_parsing():
+        eager = DznJsonAst().load_file(DZNJSON_FILE).process()
+        lazy = DznJsonAst().load_file(DZNJSON_FILE, lazy=True).process_reachable(
+            ['My', 'Project', 'ToasterSystem'])
+        for name in ['enums', 'externs', 'interfaces', 'subints', 'systems']:
+            eager_items = [repr(x) for x in getattr(eager, name)]
+            for item in getattr(lazy, name):
+                assert repr(item) in eager_items
+
+    @staticmethod
+    def test_process_reachable_not_found():
+        fc = DznJsonAst().load_file(DZNJSON_FILE, lazy=True).process_reachable(['Unknown'])
+        assert fc.systems == []
+        assert fc.interfaces == []
+
+    @staticmethod
+    def test_process_reachable_eager():
+        fc = DznJsonAst().load_file(DZNJSON_FILE).process_reachable(['Unknown'])
+        assert len(fc.interfaces) == 6  # not lazy, everything is processed
+
+
+class LazySpansTest(DznTestCase):
+
+    @staticmethod
+    def test_split_json_container():
+        buf = b' {"a": [1, "]", {"b": "\\\\"}], "c" : "x,:y" ,"d":{}} '
+        children, end = json_ast.split_json_container(buf, 1)
+        assert [buf[x[0]:x[1]] for x in children] == [b'"a"', b'[1, "]", {"b": "\\\\"}]', b'"c"',
+                                                       b'"x,:y"', b'"d"', b'{}']
+        assert end == len(buf) - 1
+
+    @staticmethod
+    def test_split_json_container_fail():
+        with pytest.raises(DznJsonError) as exc:
+            json_ast.split_json_container(b'[1, [2, 3]', 0)
+        assert str(exc.value) == 'split_json_container: unterminated JSON container'
+
+    @staticmethod
+    def test_skip_json_container():
+        buf = b'{"a": ["}", {"b": "\\""}]}, 2'
+        assert json_ast.skip_json_container(buf, 0) == buf.index(b',', buf.index(b']'))
+
+    @staticmethod
+    def test_load_json_item():
+        buf = b'[{"a": [1, 2], "b": "]"} , {"c": 3}]'
+        assert json_ast.load_json_item(buf, 1) == ({'a': [1, 2], 'b': ']'}, 24)  # up to the '}'
+        assert json_ast.load_json_item(buf, 27) == ({'c': 3}, 35)
+
+    @staticmethod
+    def test_load_json_item_non_ascii():
+        buf = '[{"a": "caf\u00e9 \u20ac"}, 1]'.encode()
+        value, end = json_ast.load_json_item(buf, 1)
+        assert value == {'a': 'caf\u00e9 \u20ac'}
+        assert buf[end:] == b', 1]'
+
+    @staticmethod
+    def test_load_json_item_edge_cases():
+        scenarios = [
+            (b'[{"a": "],[{}", "b": ","}, 1]', {'a': '],[{}', 'b': ','}),  # brackets in strings
+            (b'[{"a": "\\\\\\"]"} ,1]', {'a': '\\"]'}),  # escaped backslash and quote
+            (b'[[[1, [2]], []], {"a": [[]]}]', [[1, [2]], []]),  # nested arrays
+            (b'[{"a": "' + b'x' * (1 << 17) + b'"}]', {'a': 'x' * (1 << 17)}),  # large item
+        ]
+        for buf, expected in scenarios:
+            value, end = json_ast.load_json_item(buf, 1)
+            assert value == expected
+            assert buf[end:end + 1] in [b',', b' ', b']']
+
+    @staticmethod
+    def test_load_json_item_fail():
+        with pytest.raises(DznJsonError) as exc:
+            json_ast.load_json_item(b'[{"a": [1, 2}', 1)
+        assert str(exc.value) == 'skip_json_container: unterminated JSON container'
+
+
 # testing/assertion helpers
 
 
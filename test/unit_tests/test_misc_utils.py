@@ -6,6 +6,7 @@ This is free software, released under the MIT License. Refer to dznpy/LICENSE.
 """
 
 # system modules
+import pickle
 import pytest
 from unittest import TestCase
 
@@ -145,6 +146,46 @@ def test_plural_fail():
     assert str(exc.value) == 'Argument collection must be a collection type (str excluded)'
 
 
+def test_namespace_trail():
+    root = NamespaceTrail()
+    sut = NamespaceTrail(NamespaceTrail(root, 'My'), 'Project')
+    assert root.fqn is None
+    assert root.fqn_ids == ()
+    assert str(root) == ''
+    assert sut.fqn == ['My', 'Project']
+    assert sut.fqn_ids == ('My', 'Project')
+    assert sut.scope_name == 'Project'
+    assert str(sut) == 'My.Project'
+    assert repr(sut) == "NamespaceTrail(['My', 'Project'])"
+    assert sut.fqn_member_name(['Sub', 'Item']) == ['My', 'Project', 'Sub', 'Item']
+    sut.fqn.append('Modified')
+    assert sut.fqn == ['My', 'Project'], 'a copy of the fqn is returned'
+
+
+def test_namespace_trail_interned():
+    sut = NamespaceTrail(NamespaceTrail(NamespaceTrail(), 'My'), 'Project')
+    other = NamespaceTrail(NamespaceTrail(NamespaceTrail(), 'My'), ''.join(['Pro', 'ject']))
+    assert sut.fqn_ids is other.fqn_ids
+    assert sut == other
+    assert hash(sut) == hash(other)
+    assert sut != NamespaceTrail(NamespaceTrail(), 'My')
+    assert pickle.loads(pickle.dumps(sut)).fqn_ids is sut.fqn_ids
+
+
+def test_namespace_trail_fail():
+    with pytest.raises(ValueError) as exc:
+        NamespaceTrail(NamespaceTrail())
+    assert str(exc.value) == 'scope_name required when constructing with a parent'
+
+    with pytest.raises(ValueError) as exc:
+        NamespaceTrail(scope_name='My')
+    assert str(exc.value) == 'parent required when constructing with a scope_name'
+
+    with pytest.raises(AttributeError) as exc:
+        NamespaceTrail()._scope_name = 'My'
+    assert str(exc.value) == 'NamespaceTrail is immutable'
+
+
 class TextBlockTests(TestCase):
     @staticmethod
     def test_create_default():
@@ -194,6 +235,22 @@ class TextBlockTests(TestCase):
         assert len(tb.lines) == 3
         assert tb.lines == ['First', 'Second', 'Third']
 
+    @staticmethod
+    def test_add_other_textblock_snapshot():
+        other = TextBlock('Second')
+        tb = TextBlock('First').add(other)
+        other.add('Third').indent()
+        assert tb.lines == ['First', 'Second']
+        assert other.lines == ['    Second', '    Third']
+
+    @staticmethod
+    def test_add_textblocks_in_list():
+        tb = TextBlock(['First', TextBlock(), TextBlock(['Second', 'Third']), 'Fourth'])
+        assert tb.lines == ['First', '', 'Second', 'Third', 'Fourth']
+        assert TextBlock(TextBlock()).lines == []
+        assert TextBlock(TextBlock()).is_empty()
+        assert not TextBlock([TextBlock()]).is_empty()
+
     @staticmethod
     def test_indent_default():
         textblock = TextBlock(content=['Hello', 'There'])
@@ -217,6 +274,14 @@ class TextBlockTests(TestCase):
         textblock.indent(indentor=Indentor.TAB)
         assert str(textblock) == '\tHello\n\tThere\n'
 
+    @staticmethod
+    def test_indent_nested():
+        inner = TextBlock(['Hello', '', 'There']).indent()
+        tb = TextBlock(['{', inner, '}']).indent(indentor=Indentor.TAB).add('End')
+        assert str(tb) == '\t{\n\t    Hello\n\n\t    There\n\t}\nEnd\n'
+        assert tb.lines == ['\t{', '\t    Hello', '', '\t    There', '\t}', 'End']
+        assert str(inner.indent()) == '        Hello\n\n        There\n'
+
     @staticmethod
     def test_lines_setter():
         tb = TextBlock()
@@ -139,6 +139,8 @@ SCOPE_NAME_EX = '''{"<class>": "scope_name", "ids": ["My", "Nice", "Type"]}'''
 
 SCOPE_NAME_FAIL = '''{"<class>": "scope_name", "ids": []}'''
 
+SCOPE_NAME_FAIL_OTHER_TYPE = '''{"<class>": "scope_name", "ids": ["My", 1]}'''
+
 SUBINT = '''{"<class>": "subint",
              "name": {"<class>": "scope_name", "ids": ["SmallInt"]},
              "range": ''' f'{RANGE}' '''}'''